@@ -5,10 +5,13 @@ use criterion::{
     measurement::Measurement,
 };
 use prost::Message;
+use std::alloc::{AllocError, Allocator, Global, Layout};
+use std::ptr::NonNull;
+use std::sync::atomic::{AtomicUsize, Ordering};
 
 // Your crate
 use codegen_tests::{Test::ProtoType as Test, make_large, make_medium, make_small};
-use protocrap::{ProtobufExt, arena};
+use protocrap::{ProtobufMut, ProtobufRef, arena, decoding::ResumeableDecode};
 
 mod prost_gen {
     include!(concat!(env!("OUT_DIR"), "/_.rs"));
@@ -25,7 +28,7 @@ fn bench_decoding(
         let mut arena = crate::arena::Arena::new(&std::alloc::Global);
         let mut msg = Test::default();
         b.iter(|| {
-            msg.nested_message_mut().clear();
+            msg.reuse_clear(&mut arena);
             let _ = msg.decode_flat::<32>(&mut arena, black_box(data));
             black_box(&msg as *const _);
         })
@@ -63,6 +66,55 @@ fn bench_decode(c: &mut Criterion) {
     group.finish();
 }
 
+// Feeds the message to the resumable decoder in small chunks, so nearly every field that
+// crosses a chunk boundary goes through the decoder's step transitions. Compare runs with
+// and without the `tail_calls` feature to measure the threaded decoder.
+fn bench_chunked_decoding(
+    group: &mut BenchmarkGroup<'_, impl Measurement>,
+    bench_function_name: &str,
+    data: &[u8],
+    chunk_size: usize,
+) {
+    group.throughput(Throughput::Bytes(data.len() as u64));
+
+    group.bench_function(
+        &format!("{}/chunk{}/protocrap", bench_function_name, chunk_size),
+        |b| {
+            let mut arena = crate::arena::Arena::new(&std::alloc::Global);
+            let mut msg = Test::default();
+            b.iter(|| {
+                msg.reuse_clear(&mut arena);
+                let mut decoder = ResumeableDecode::<32>::new(&mut msg, isize::MAX);
+                for chunk in black_box(data).chunks(chunk_size) {
+                    if !decoder.resume(chunk, &mut arena) {
+                        break;
+                    }
+                }
+                black_box(decoder.finish(&mut arena));
+            })
+        },
+    );
+}
+
+fn bench_decode_chunked(c: &mut Criterion) {
+    let mut group = c.benchmark_group("decode_chunked");
+
+    let mut medium_arena = arena::Arena::new(&std::alloc::Global);
+    let medium_data = make_medium(&mut medium_arena)
+        .encode_vec::<32>()
+        .expect("should encode");
+    bench_chunked_decoding(&mut group, "medium", &medium_data, 64);
+
+    let mut large_arena = arena::Arena::new(&std::alloc::Global);
+    let large_data = make_large(&mut large_arena)
+        .encode_vec::<32>()
+        .expect("should encode");
+    bench_chunked_decoding(&mut group, "large", &large_data, 64);
+    bench_chunked_decoding(&mut group, "large", &large_data, 4096);
+
+    group.finish();
+}
+
 fn bench_encoding(
     c: &mut BenchmarkGroup<'_, impl Measurement>,
     bench_function_name: &str,
@@ -111,6 +163,69 @@ fn bench_encode(c: &mut Criterion) {
     group.finish();
 }
 
+// Counts allocator calls, to show that a reset arena stops allocating after warm-up.
+struct CountingAllocator(AtomicUsize);
+
+unsafe impl Allocator for CountingAllocator {
+    fn allocate(&self, layout: Layout) -> Result<NonNull<[u8]>, AllocError> {
+        self.0.fetch_add(1, Ordering::Relaxed);
+        Global.allocate(layout)
+    }
+
+    unsafe fn deallocate(&self, ptr: NonNull<u8>, layout: Layout) {
+        unsafe { Global.deallocate(ptr, layout) }
+    }
+}
+
+fn decode_into_arena(arena: &mut arena::Arena, data: &[u8]) {
+    let mut msg = Test::default();
+    let _ = msg.decode_flat::<32>(arena, black_box(data));
+    black_box(&msg as *const _);
+}
+
+// One arena per request, either dropped or reset after each decode.
+fn bench_arena_reuse(c: &mut Criterion) {
+    let mut group = c.benchmark_group("arena_reuse");
+
+    let mut large_arena = arena::Arena::new(&Global);
+    let large_data = make_large(&mut large_arena)
+        .encode_vec::<32>()
+        .expect("should encode");
+    group.throughput(Throughput::Bytes(large_data.len() as u64));
+
+    let allocator = CountingAllocator(AtomicUsize::new(0));
+    let mut arena = arena::Arena::new(&allocator);
+    for _ in 0..10 {
+        decode_into_arena(&mut arena, &large_data);
+        arena.reset();
+    }
+    allocator.0.store(0, Ordering::Relaxed);
+    for _ in 0..1000 {
+        decode_into_arena(&mut arena, &large_data);
+        arena.reset();
+    }
+    println!(
+        "arena_reuse/large: {} allocator calls per decode after warm-up with reset",
+        allocator.0.load(Ordering::Relaxed) as f64 / 1000.0
+    );
+
+    group.bench_function("large/drop", |b| {
+        b.iter(|| {
+            let mut arena = arena::Arena::new(&Global);
+            decode_into_arena(&mut arena, &large_data);
+        })
+    });
+
+    group.bench_function("large/reset", |b| {
+        let mut arena = arena::Arena::new(&Global);
+        b.iter(|| {
+            decode_into_arena(&mut arena, &large_data);
+            arena.reset();
+        })
+    });
+    group.finish();
+}
+
 #[inline(never)]
 pub fn push_loop_protocrap_inner(arena: &mut arena::Arena) {
     let mut repeated_field = protocrap::containers::RepeatedField::<i32>::new();
@@ -152,5 +267,12 @@ fn bench_repeated_field(c: &mut Criterion) {
     group.finish();
 }
 
-criterion_group!(benches, bench_decode, bench_encode, bench_repeated_field);
+criterion_group!(
+    benches,
+    bench_decode,
+    bench_decode_chunked,
+    bench_encode,
+    bench_arena_reuse,
+    bench_repeated_field
+);
 criterion_main!(benches);
@@ -1,5 +1,6 @@
 // build.rs
 
+use protocrap_codegen::LayoutOptions;
 use std::io::Result;
 use std::path::Path;
 
@@ -7,17 +8,63 @@ fn main() -> Result<()> {
     let out_dir = std::env::var("OUT_DIR").unwrap();
 
     println!("cargo:rerun-if-changed=proto/test.proto");
+    println!("cargo:rerun-if-changed=proto/inline.proto");
+    println!("cargo:rerun-if-changed=proto/packed.proto");
+    println!("cargo:rerun-if-changed=proto/text.proto");
 
     // Generate protocrap version with Rust codegen
     println!("cargo:warning=Generating protocrap version with Rust codegen...");
 
     // Generate test.proto (includes Test and DefaultsTest messages)
-    generate_proto(&out_dir, "proto/test.proto", "test.pc.rs")?;
+    generate_proto(
+        &out_dir,
+        "proto/test.proto",
+        "test.pc.rs",
+        LayoutOptions::default(),
+    )?;
+
+    // Generate inline.proto with repeated and small singular submessages stored inline
+    generate_proto(
+        &out_dir,
+        "proto/inline.proto",
+        "inline.pc.rs",
+        LayoutOptions {
+            inline_repeated_messages: true,
+            max_inline_message_size: 64,
+            ..Default::default()
+        },
+    )?;
+
+    // Generate packed.proto with the fields ordered to minimize padding and bools as bits
+    generate_proto(
+        &out_dir,
+        "proto/packed.proto",
+        "packed.pc.rs",
+        LayoutOptions {
+            max_inline_message_size: 64,
+            reorder_fields: true,
+            bool_bits: true,
+            ..Default::default()
+        },
+    )?;
+
+    // Generate text.proto, a proto3 file whose strings are validated as UTF-8
+    generate_proto(
+        &out_dir,
+        "proto/text.proto",
+        "text.pc.rs",
+        LayoutOptions::default(),
+    )?;
 
     Ok(())
 }
 
-fn generate_proto(out_dir: &str, proto_file: &str, output_name: &str) -> Result<()> {
+fn generate_proto(
+    out_dir: &str,
+    proto_file: &str,
+    output_name: &str,
+    options: LayoutOptions,
+) -> Result<()> {
     let desc_file = format!("{}/temp.desc", out_dir);
     let output_file = format!("{}/{}", out_dir, output_name);
 
@@ -46,7 +93,7 @@ fn generate_proto(out_dir: &str, proto_file: &str, output_name: &str) -> Result<
     let descriptor_bytes = std::fs::read(&desc_file)?;
 
     // Generate Rust code with protocrap-codegen
-    let code = protocrap_codegen::generate(&descriptor_bytes).map_err(|e| {
+    let code = protocrap_codegen::generate_with_options(&descriptor_bytes, options).map_err(|e| {
         std::io::Error::new(
             std::io::ErrorKind::Other,
             format!("Code generation failed: {}", e),
@@ -6,6 +6,9 @@ use protocrap::tests::assert_roundtrip;
 use protocrap::{Protobuf, ProtobufRef};
 use protocrap::{self, containers::Bytes};
 include!(concat!(env!("OUT_DIR"), "/test.pc.rs"));
+include!(concat!(env!("OUT_DIR"), "/inline.pc.rs"));
+include!(concat!(env!("OUT_DIR"), "/packed.pc.rs"));
+include!(concat!(env!("OUT_DIR"), "/text.pc.rs"));
 
 use Test::ProtoType as TestProto;
 
@@ -112,7 +115,714 @@ fn test_file_descriptor_serde_serialization() {
     );
 }
 
+#[cfg(test)]
+fn assert_encoded_len<T: Protobuf>(msg: &T) {
+    let mut buffer = vec![0u8; 1 << 20];
+    let flat = msg
+        .encode_flat::<100>(&mut buffer)
+        .expect("msg should encode");
+    assert_eq!(msg.encoded_len::<100>(), Some(flat.len()));
+
+    let mut vec = b"prefix".to_vec();
+    msg.encode_into_vec::<100>(&mut vec)
+        .expect("msg should encode");
+    assert_eq!(&vec[..6], b"prefix");
+    assert_eq!(&vec[6..], flat);
+
+    // Encodes into the existing capacity without reallocating
+    let mut exact = Vec::with_capacity(flat.len());
+    let ptr = exact.as_ptr();
+    msg.encode_into_vec::<100>(&mut exact)
+        .expect("msg should encode");
+    assert_eq!(exact.as_ptr(), ptr);
+    assert_eq!(exact, flat);
+}
+
+#[test]
+fn test_encoded_len() {
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    assert_encoded_len(&make_small());
+    assert_encoded_len(&make_medium(&mut arena));
+    assert_encoded_len(&make_large(&mut arena));
+    assert_encoded_len(
+        protocrap::google::protobuf::FileDescriptorProto::ProtoType::file_descriptor(),
+    );
+    // Submessages need stack depth
+    assert_eq!(make_large(&mut arena).encoded_len::<0>(), None);
+}
+
+#[cfg(test)]
+fn assert_forward_encode<T: Protobuf>(msg: &T) {
+    let expected = msg.encode_vec::<100>().expect("msg should encode");
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    for chunk_size in [1, 7, 16, 17, 33, 100, 4096] {
+        let mut encoder = protocrap::encoding::ForwardEncode::<100>::new(msg, &mut arena)
+            .expect("msg should size");
+        assert_eq!(encoder.encoded_len(), expected.len());
+        let mut chunk = vec![0u8; chunk_size];
+        let mut out = Vec::new();
+        loop {
+            match encoder
+                .resume_encode(&mut chunk)
+                .expect("msg should encode")
+            {
+                protocrap::encoding::ForwardResult::Done(len) => {
+                    out.extend_from_slice(&chunk[..len]);
+                    break;
+                }
+                protocrap::encoding::ForwardResult::Full => out.extend_from_slice(&chunk),
+            }
+        }
+        assert_eq!(out, expected, "chunk_size={}", chunk_size);
+    }
+
+    let mut out = Vec::new();
+    msg.encode_to_write::<100, 64>(&mut arena, &mut out)
+        .expect("msg should encode");
+    assert_eq!(out, expected);
+}
+
+#[test]
+fn test_forward_encode() {
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    assert_forward_encode(&make_small());
+    assert_forward_encode(&make_medium(&mut arena));
+    assert_forward_encode(&make_large(&mut arena));
+    assert_forward_encode(
+        protocrap::google::protobuf::FileDescriptorProto::ProtoType::file_descriptor(),
+    );
+}
+
+#[test]
+fn test_aliased_decode() {
+    use protocrap::ProtobufMut;
+
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let data = make_large(&mut arena)
+        .encode_vec::<32>()
+        .expect("msg should encode");
+    let msg = TestProto::default()
+        .decode_flat_aliased::<32>(&mut arena, &data)
+        .expect("msg should decode");
+    assert_eq!(msg.encode_vec::<32>().expect("msg should encode"), data);
+
+    let input = data.as_ptr_range();
+    let aliased = msg
+        .rep_bytes()
+        .iter()
+        .filter(|bytes| input.contains(&bytes.as_ptr()))
+        .count();
+    // Only payloads in the last SLOP_SIZE bytes of the input go through the patch buffer
+    assert!(aliased >= msg.rep_bytes().len() - 1);
+}
+
 // Chunked streaming tests
+#[test]
+fn test_lazy_submessage() {
+    use protocrap::ProtobufMut;
+
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let mut msg = make_medium(&mut arena);
+    *msg.lazy_child_mut(&mut arena) = make_large(&mut arena);
+    let data = msg.encode_vec::<32>().expect("msg should encode");
+
+    let mut decoded = TestProto::default();
+    assert!(decoded.decode_flat::<32>(&mut arena, &data));
+    // Untouched and read-only accessed lazy fields are written out as decoded
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), data);
+    let child = decoded.lazy_child().expect("lazy child should be set");
+    assert_eq!(child.nested_message().len(), 100);
+    assert_eq!(child.rep_bytes().len(), 5);
+    assert!(format!("{:?}", decoded).contains("lazy_child"));
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), data);
+
+    decoded.lazy_child_mut(&mut arena).set_x(7);
+    let modified = decoded.encode_vec::<32>().expect("msg should encode");
+    let mut reference = make_medium(&mut arena);
+    let child = reference.lazy_child_mut(&mut arena);
+    *child = make_large(&mut arena);
+    child.set_x(7);
+    assert_eq!(modified, reference.encode_vec::<32>().expect("msg should encode"));
+
+    // A repeated occurrence merges into the lazy field
+    let mut update = TestProto::default();
+    update.lazy_child_mut(&mut arena).set_z("merged", &mut arena);
+    let mut merged_data = data.clone();
+    merged_data.extend(update.encode_vec::<32>().expect("msg should encode"));
+    let mut merged = TestProto::default();
+    assert!(merged.decode_flat::<32>(&mut arena, &merged_data));
+    let child = merged.lazy_child().expect("lazy child should be set");
+    assert_eq!(child.x(), 42);
+    assert_eq!(child.z(), "merged");
+
+    // Once decoded, further occurrences are merged into the object
+    let update_data = update.encode_vec::<32>().expect("msg should encode");
+    assert!(decoded.decode_flat::<32>(&mut arena, &update_data));
+    let child = decoded.lazy_child().expect("lazy child should be set");
+    assert_eq!(child.x(), 7);
+    assert_eq!(child.z(), "merged");
+
+    // A payload with a truncated z is only rejected on access
+    let invalid = [0x42, 2, 0x1a, 1];
+    let mut decoded = TestProto::default();
+    assert!(decoded.decode_flat::<32>(&mut arena, &invalid));
+    assert!(decoded.has_lazy_child() && decoded.lazy_child().is_none());
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), invalid);
+    assert!(!decoded.decode_flat::<32>(&mut arena, &invalid));
+    let mut decoded = TestProto::default();
+    assert!(decoded.decode_flat::<32>(&mut arena, &invalid));
+    let child = decoded.lazy_child_mut(&mut arena);
+    assert!(!child.has_z());
+    child.set_x(1);
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), [0x42, 2, 8, 1]);
+
+    // A small lazy field decodes into the slice of the arena it was given, not a new block
+    let mut small = TestProto::default();
+    let child = small.lazy_child_mut(&mut arena);
+    child.set_x(1);
+    child.set_z("small", &mut arena);
+    let small_data = small.encode_vec::<32>().expect("msg should encode");
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let mut decoded = TestProto::default();
+    assert!(decoded.decode_flat::<32>(&mut arena, &small_data));
+    let bytes_allocated = arena.bytes_allocated();
+    assert_eq!(decoded.lazy_child().expect("lazy child should be set").z(), "small");
+    assert_eq!(arena.bytes_allocated(), bytes_allocated);
+}
+
+#[test]
+fn test_projection() {
+    use protocrap::ProtobufMut;
+    use protocrap::projection::Projection;
+
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let mut msg = make_large(&mut arena);
+    let child = msg.child1_mut(&mut arena);
+    child.set_x(123);
+    child.set_z("not selected", &mut arena);
+    let data = msg.encode_vec::<32>().expect("msg should encode");
+
+    let table = <TestProto as Protobuf>::table();
+    let projection = Projection::new(
+        table,
+        &["y", "child1.x", "nested_message"],
+        &std::alloc::Global,
+    )
+    .expect("paths should compile");
+    let mut reference = TestProto::default();
+    reference.set_y(0xDEADBEEF);
+    reference.child1_mut(&mut arena).set_x(123);
+    for i in 0..100 {
+        reference.add_nested_message(&mut arena).set_x(i);
+    }
+    let expected = reference.encode_vec::<32>().expect("msg should encode");
+
+    let mut decoded = TestProto::default();
+    assert!(
+        projection
+            .view_mut(&mut decoded)
+            .decode_flat::<32>(&mut arena, &data)
+    );
+    assert!(!decoded.has_x());
+    assert!(decoded.rep_bytes().is_empty());
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), expected);
+
+    let projected = projection
+        .view(&msg)
+        .encode_vec::<32>()
+        .expect("msg should encode");
+    assert_eq!(projected, expected);
+
+    assert!(Projection::new(table, &["child1.w"], &std::alloc::Global).is_err());
+    assert!(Projection::new(table, &["x.y"], &std::alloc::Global).is_err());
+    assert!(Projection::new(table, &["lazy_child.x"], &std::alloc::Global).is_err());
+}
+
+#[test]
+fn test_string_validation() {
+    use protocrap::ProtobufMut;
+    use protocrap::decoding::ResumeableDecode;
+    use text::Text::ProtoType as TextProto;
+
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let text = "Grüße, 世界! 😀 ".repeat(8);
+    let mut msg = TextProto::default();
+    msg.set_s(&text, &mut arena);
+    msg.set_b(b"\xff not a string", &mut arena);
+    let data = msg.encode_vec::<32>().expect("msg should encode");
+
+    // Overwrite the last byte of the emoji in the middle of the string
+    let corrupt = |data: &[u8]| {
+        let mut invalid = data.to_vec();
+        let emoji = data
+            .windows(4)
+            .enumerate()
+            .filter(|(_, w)| *w == "😀".as_bytes())
+            .nth(4)
+            .expect("string should be encoded")
+            .0;
+        invalid[emoji + 3] = b'!';
+        invalid
+    };
+    let invalid = corrupt(&data);
+
+    let decode_chunked = |data: &[u8], chunk_size: usize, arena: &mut protocrap::arena::Arena| {
+        let mut decoded = TextProto::default();
+        let mut decoder = ResumeableDecode::<32>::new(&mut decoded, isize::MAX);
+        for chunk in data.chunks(chunk_size) {
+            if !decoder.resume(chunk, arena) {
+                return None;
+            }
+        }
+        decoder.finish(arena).then_some(decoded)
+    };
+    let mut decoded = TextProto::default();
+    assert!(decoded.decode_flat::<32>(&mut arena, &data));
+    assert_eq!(decoded.s(), text);
+    assert!(!TextProto::default().decode_flat::<32>(&mut arena, &invalid));
+    for chunk_size in 1..=40 {
+        let decoded = decode_chunked(&data, chunk_size, &mut arena)
+            .unwrap_or_else(|| panic!("chunk size {chunk_size} should decode"));
+        assert_eq!(decoded.s(), text);
+        assert!(decode_chunked(&invalid, chunk_size, &mut arena).is_none());
+    }
+    // Repeated strings are validated too
+    assert!(!TextProto::default().decode_flat::<32>(&mut arena, &[0x12, 1, 0xff]));
+
+    // Proto2 strings are not validated, invalid UTF-8 round trips as is
+    let mut msg = TestProto::default();
+    msg.set_z(&text, &mut arena);
+    let invalid = corrupt(&msg.encode_vec::<32>().expect("msg should encode"));
+    let mut decoded = TestProto::default();
+    assert!(decoded.decode_flat::<32>(&mut arena, &invalid));
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), invalid);
+}
+
+#[test]
+fn test_failed_decode_rolls_back() {
+    use protocrap::ProtobufMut;
+
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let mut msg = make_large(&mut arena);
+    *msg.lazy_child_mut(&mut arena) = make_large(&mut arena);
+    msg.rep_bytes_mut()
+        .push(Bytes::from_slice(&[7; 64 * 1024], &mut arena), &mut arena);
+    let data = msg.encode_vec::<32>().expect("msg should encode");
+    let truncated = &data[..data.len() - 1];
+
+    let mut decoded = make_medium(&mut arena);
+    let probe = arena.alloc::<u8>();
+    assert!(!decoded.decode_flat::<32>(&mut arena, truncated));
+    // The arena continues where it was before the decode, and the message is cleared
+    assert_eq!(arena.alloc::<u8>(), probe.wrapping_add(1));
+    assert!(decoded.encode_vec::<32>().expect("msg should encode").is_empty());
+
+    let probe = arena.alloc::<u8>();
+    assert!(decoded.decode_from_read::<32>(&mut arena, &mut &*truncated).is_err());
+    assert_eq!(arena.alloc::<u8>(), probe.wrapping_add(1));
+
+    // The retry reuses the memory released by the failed decodes
+    let allocated = arena.bytes_allocated();
+    assert!(decoded.decode_flat::<32>(&mut arena, &data));
+    assert_eq!(arena.bytes_allocated(), allocated);
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), data);
+}
+
+#[test]
+fn test_decode_memory_limit() {
+    use protocrap::ProtobufMut;
+    use protocrap::decoding::ResumeableDecode;
+
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let mut msg = make_large(&mut arena);
+    for i in 0..10_000 {
+        msg.add_nested_message(&mut arena).set_x(i);
+    }
+    let data = msg.encode_vec::<32>().expect("msg should encode");
+
+    let mut limited = protocrap::arena::Arena::new(&std::alloc::Global);
+    limited.set_memory_limit(64 * 1024);
+    let mut decoded = TestProto::default();
+    assert!(!decoded.decode_flat::<32>(&mut limited, &data));
+    assert!(limited.bytes_allocated() <= 64 * 1024);
+    for chunk_size in [1, 7, 100, 4096] {
+        let mut decoded = TestProto::default();
+        let mut decoder = ResumeableDecode::<32>::new(&mut decoded, isize::MAX);
+        let ok = data
+            .chunks(chunk_size)
+            .all(|chunk| decoder.resume(chunk, &mut limited));
+        assert!(!ok || !decoder.finish(&mut limited));
+        assert!(limited.bytes_allocated() <= 64 * 1024);
+    }
+
+    limited.set_memory_limit(usize::MAX);
+    assert!(decoded.decode_flat::<32>(&mut limited, &data));
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), data);
+
+    // Lazy fields are decoded within what is left of the limit
+    let mut lazy = TestProto::default();
+    *lazy.lazy_child_mut(&mut arena) = msg;
+    let data = lazy.encode_vec::<32>().expect("msg should encode");
+    for limit in [4 * data.len(), usize::MAX] {
+        let mut limited = protocrap::arena::Arena::new(&std::alloc::Global);
+        limited.set_memory_limit(limit);
+        let mut decoded = TestProto::default();
+        assert!(decoded.decode_flat::<32>(&mut limited, &data));
+        assert!(decoded.has_lazy_child());
+        assert_eq!(decoded.lazy_child().is_some(), limit == usize::MAX);
+    }
+
+    // Lazy fields share the limit, two that each fit it alone do not fit together
+    let fill = |child: &mut TestProto, arena: &mut protocrap::arena::Arena| {
+        for i in 0..10_000 {
+            child.add_nested_message(arena).set_x(i);
+        }
+    };
+    let mut lazy = TestProto::default();
+    fill(lazy.lazy_child_mut(&mut arena), &mut arena);
+    fill(lazy.child1_mut(&mut arena).lazy_child_mut(&mut arena), &mut arena);
+    let data = lazy.encode_vec::<32>().expect("msg should encode");
+    let mut unlimited = protocrap::arena::Arena::new(&std::alloc::Global);
+    let mut decoded = TestProto::default();
+    assert!(decoded.decode_flat::<32>(&mut unlimited, &data));
+    let decoded_size = unlimited.bytes_allocated();
+    assert!(decoded.lazy_child().is_some());
+    let lazy_size = unlimited.bytes_allocated() - decoded_size;
+    let mut limited = protocrap::arena::Arena::new(&std::alloc::Global);
+    limited.set_memory_limit(decoded_size + lazy_size * 3 / 2);
+    let mut decoded = TestProto::default();
+    assert!(decoded.decode_flat::<32>(&mut limited, &data));
+    assert!(decoded.lazy_child().is_some());
+    assert!(decoded.child1().unwrap().lazy_child().is_none());
+    assert!(limited.bytes_allocated() <= decoded_size + lazy_size * 3 / 2);
+}
+
+#[test]
+fn test_reuse_clear() {
+    use protocrap::ProtobufMut;
+
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let mut msg = make_large(&mut arena);
+    *msg.child1_mut(&mut arena) = make_medium(&mut arena);
+    *msg.lazy_child_mut(&mut arena) = make_large(&mut arena);
+    let data = msg.encode_vec::<32>().expect("msg should encode");
+
+    // The first decodes allocate, until the recycled buffers have settled in size
+    let mut decoded = TestProto::default();
+    for _ in 0..3 {
+        unsafe { decoded.reuse_clear(&mut arena) };
+        assert!(decoded.decode_flat::<32>(&mut arena, &data));
+    }
+    // From now on decoding only reuses the memory of the previous decode
+    let probe = arena.alloc::<u8>();
+    for _ in 0..3 {
+        unsafe { decoded.reuse_clear(&mut arena) };
+        assert!(decoded.decode_flat::<32>(&mut arena, &data));
+        assert_eq!(decoded.lazy_child().map(|child| child.x()), Some(42));
+        assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), data);
+    }
+    assert_eq!(arena.alloc::<u8>(), probe.wrapping_add(1));
+
+    // No fields of the previous decode are left behind
+    let small = make_small().encode_vec::<32>().expect("msg should encode");
+    unsafe { decoded.reuse_clear(&mut arena) };
+    assert!(decoded.decode_flat::<32>(&mut arena, &small));
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), small);
+}
+
+#[test]
+fn test_inline_repeated_messages() {
+    use protocrap::ProtobufMut;
+    use protocrap::reflection::{DescriptorPool, LayoutOptions, Value};
+
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let mut tree = inline::Tree::ProtoType::default();
+    tree.set_x(1);
+    tree.set_name("root", &mut arena);
+    for i in 0..10 {
+        let child = tree.add_children(&mut arena);
+        child.set_x(i);
+        child.set_name("child", &mut arena);
+        child.add_leaves(&mut arena).set_value(-(i as i64));
+    }
+    for i in 0..100 {
+        let leaf = tree.add_leaves(&mut arena);
+        leaf.set_value(i);
+        leaf.data_mut()
+            .push(Bytes::from_slice(b"leaf", &mut arena), &mut arena);
+    }
+    tree.add_group(&mut arena).set_y(7);
+
+    // Elements are stored one after the other
+    let leaves = tree.leaves();
+    assert_eq!(
+        &leaves[1] as *const _ as usize - &leaves[0] as *const _ as usize,
+        core::mem::size_of::<inline::Leaf::ProtoType>()
+    );
+    assert_roundtrip(&tree);
+    assert_encoded_len(&tree);
+    assert_forward_encode(&tree);
+    assert_json_roundtrip(&tree);
+
+    let data = tree.encode_vec::<32>().expect("msg should encode");
+    let mut decoded = inline::Tree::ProtoType::default();
+    assert!(decoded.decode_flat::<32>(&mut arena, &data));
+    assert_eq!(decoded.children().len(), 10);
+    assert_eq!(decoded.children()[3].leaves()[0].value(), -3);
+    assert_eq!(decoded.leaves()[99].value(), 99);
+
+    // Decoding again after reuse_clear leaves no elements behind
+    unsafe { decoded.reuse_clear(&mut arena) };
+    assert!(decoded.leaves().is_empty());
+    assert!(decoded.decode_flat::<32>(&mut arena, &data));
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), data);
+
+    // The elements get back the memory of the cleared ones, so the arena stops growing
+    for _ in 0..2 {
+        unsafe { decoded.reuse_clear(&mut arena) };
+        assert!(decoded.decode_flat::<32>(&mut arena, &data));
+    }
+    let allocated = arena.bytes_allocated();
+    let probe = arena.alloc::<u8>();
+    for _ in 0..10 {
+        unsafe { decoded.reuse_clear(&mut arena) };
+        assert!(decoded.decode_flat::<32>(&mut arena, &data));
+        assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), data);
+    }
+    assert_eq!(arena.alloc::<u8>(), probe.wrapping_add(1));
+    assert_eq!(arena.bytes_allocated(), allocated);
+
+    // A pool with the same layout reads the generated layout
+    let layout = LayoutOptions {
+        inline_repeated_messages: true,
+        max_inline_message_size: 64,
+        ..Default::default()
+    };
+    let mut pool = DescriptorPool::with_layout(&std::alloc::Global, layout);
+    pool.add_file(inline::Tree::ProtoType::file_descriptor());
+    let table = pool.get_table("inline.Tree").expect("table should exist");
+    assert_eq!(table.size, <inline::Tree::ProtoType as Protobuf>::table().size);
+    let dynamic = pool
+        .decode_message("inline.Tree", &data, &mut arena)
+        .expect("msg should decode");
+    assert_eq!(dynamic.encode_vec::<32>().expect("msg should encode"), data);
+    let field = dynamic.find_field_descriptor("leaves").unwrap();
+    let Some(Value::RepeatedMessage(leaves)) = dynamic.get_field(field) else {
+        panic!("leaves should be set");
+    };
+    assert_eq!(leaves.len(), 100);
+
+    // Empty messages take no memory
+    let mut holder = inline::Holder::ProtoType::default();
+    for _ in 0..3 {
+        holder.add_empties(&mut arena);
+    }
+    assert_eq!(holder.empties().len(), 3);
+    assert_roundtrip(&holder);
+}
+
+#[test]
+fn test_inline_messages() {
+    use protocrap::ProtobufMut;
+    use protocrap::reflection::{DescriptorPool, LayoutOptions, Value};
+
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let mut tree = inline::Tree::ProtoType::default();
+    assert!(!tree.has_origin());
+    assert!(tree.origin().is_none());
+    tree.origin_mut(&mut arena).set_y(-5);
+    tree.best_mut(&mut arena)
+        .data_mut()
+        .push(Bytes::from_slice(b"best", &mut arena), &mut arena);
+    tree.parent_mut(&mut arena).set_x(9);
+    assert!(tree.has_origin());
+    assert_eq!(tree.origin().unwrap().y(), -5);
+
+    // Small submessages are part of the struct, recursive ones are not
+    assert!(
+        core::mem::size_of::<inline::Tree::ProtoType>()
+            > core::mem::size_of::<inline::Point::ProtoType>()
+                + core::mem::size_of::<inline::Leaf::ProtoType>()
+    );
+    assert_roundtrip(&tree);
+    assert_encoded_len(&tree);
+    assert_forward_encode(&tree);
+    assert_json_roundtrip(&tree);
+
+    let data = tree.encode_vec::<32>().expect("msg should encode");
+    let mut decoded = inline::Tree::ProtoType::default();
+    assert!(decoded.decode_flat::<32>(&mut arena, &data));
+    assert_eq!(decoded.origin().unwrap().y(), -5);
+    assert_eq!(decoded.best().unwrap().data()[0].slice(), b"best");
+    assert_eq!(decoded.parent().unwrap().x(), 9);
+
+    // An empty submessage that is set is still encoded
+    decoded.clear_best();
+    decoded.best_mut(&mut arena);
+    let mut reread = inline::Tree::ProtoType::default();
+    assert!(reread.decode_flat::<32>(&mut arena, &decoded.encode_vec::<32>().unwrap()));
+    assert!(reread.has_best());
+    decoded.clear_origin();
+    assert!(!decoded.has_origin());
+    assert_roundtrip(&decoded);
+
+    // reuse_clear leaves the embedded messages unset and empty
+    unsafe { decoded.reuse_clear(&mut arena) };
+    assert!(!decoded.has_best());
+    assert!(decoded.decode_flat::<32>(&mut arena, &data));
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), data);
+
+    // A pool with the same layout reads the generated layout
+    let layout = LayoutOptions {
+        inline_repeated_messages: true,
+        max_inline_message_size: 64,
+        ..Default::default()
+    };
+    let mut pool = DescriptorPool::with_layout(&std::alloc::Global, layout);
+    pool.add_file(inline::Tree::ProtoType::file_descriptor());
+    let table = pool.get_table("inline.Tree").expect("table should exist");
+    assert_eq!(table.size, <inline::Tree::ProtoType as Protobuf>::table().size);
+    let dynamic = pool
+        .decode_message("inline.Tree", &data, &mut arena)
+        .expect("msg should decode");
+    assert_eq!(dynamic.encode_vec::<32>().expect("msg should encode"), data);
+    let field = dynamic.find_field_descriptor("origin").unwrap();
+    let Some(Value::Message(origin)) = dynamic.get_field(field) else {
+        panic!("origin should be set");
+    };
+    assert_eq!(
+        origin.as_object() as *const _ as usize - dynamic.as_object() as *const _ as usize,
+        decoded.origin().unwrap() as *const _ as usize - &decoded as *const _ as usize
+    );
+}
+
+#[test]
+fn test_reordered_fields() {
+    use protocrap::reflection::{DescriptorPool, DynamicMessageRef, LayoutOptions, MessageLayouts};
+
+    let options = LayoutOptions {
+        max_inline_message_size: 64,
+        reorder_fields: true,
+        bool_bits: true,
+        ..Default::default()
+    };
+    let file_descriptor = packed::Padded::ProtoType::file_descriptor();
+    let mut layouts = MessageLayouts::new(options);
+    layouts.add_file(file_descriptor);
+    let layout = layouts.layout(file_descriptor.message_type()[0]);
+    assert_eq!(layout.size as usize, core::mem::size_of::<packed::Padded::ProtoType>());
+    assert!(layout.size < layout.declared_size);
+
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let mut msg = packed::Padded::ProtoType::default();
+    msg.set_a(true);
+    msg.set_b(-2);
+    msg.set_c(true);
+    msg.set_d(4.5);
+    msg.set_e("five", &mut arena);
+    msg.set_f(6);
+    msg.set_g(true);
+    msg.h_mut().push(8, &mut arena);
+    msg.point_mut(&mut arena).set_x(-9);
+    msg.next_mut(&mut arena).set_b(10);
+    assert_roundtrip(&msg);
+    assert_encoded_len(&msg);
+    assert_forward_encode(&msg);
+    assert_json_roundtrip(&msg);
+
+    // The pool places every field at the same offset as the generated struct
+    let mut pool = DescriptorPool::with_layout(&std::alloc::Global, options);
+    pool.add_file(file_descriptor);
+    let table = pool.get_table("packed.Padded").expect("table should exist");
+    let view = DynamicMessageRef {
+        object: ProtobufRef::as_object(&msg),
+        table,
+    };
+    assert_eq!(
+        view.encode_vec::<32>().expect("msg should encode"),
+        msg.encode_vec::<32>().expect("msg should encode")
+    );
+    assert_eq!(format!("{:?}", view), format!("{:?}", msg));
+}
+
+#[test]
+fn test_bool_bits() {
+    use protocrap::ProtobufMut;
+    use protocrap::reflection::{DescriptorPool, DynamicMessageRef, LayoutOptions, Value};
+
+    // 14 has bits and 13 values fit in one word, followed by level and the repeated fields
+    assert_eq!(
+        core::mem::size_of::<packed::Flags::ProtoType>(),
+        8 + 2 * core::mem::size_of::<protocrap::containers::RepeatedField<bool>>()
+    );
+
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let mut flags = packed::Flags::ProtoType::default();
+    assert!(!flags.f3());
+    assert!(flags.enabled());
+    flags.set_f1(true);
+    flags.set_f3(false);
+    flags.set_f12(true);
+    flags.set_enabled(false);
+    flags.set_level(3);
+    flags.history_mut().push(true, &mut arena);
+    assert!(flags.f1() && flags.f12() && !flags.enabled());
+    assert_eq!(flags.get_f3(), Some(false));
+    assert_eq!(flags.get_f2(), None);
+    assert_roundtrip(&flags);
+    assert_encoded_len(&flags);
+    assert_forward_encode(&flags);
+    assert_json_roundtrip(&flags);
+
+    flags.clear_f1();
+    assert!(!flags.has_f1() && !flags.f1());
+    flags.clear_enabled();
+    assert!(flags.enabled());
+
+    let data = flags.encode_vec::<32>().expect("msg should encode");
+    let mut decoded = packed::Flags::ProtoType::default();
+    assert!(decoded.decode_flat::<32>(&mut arena, &data));
+    assert!(decoded.f12() && decoded.has_f3() && !decoded.f3());
+    unsafe { decoded.reuse_clear(&mut arena) };
+    assert!(!decoded.has_f12() && !decoded.f12());
+    assert!(decoded.decode_flat::<32>(&mut arena, &data));
+    assert_eq!(decoded.encode_vec::<32>().expect("msg should encode"), data);
+
+    // Map entries store their bools as bits too
+    let json = r#"{"overrides": {"true": false}}"#;
+    let with_map = {
+        let mut deserializer = serde_json::Deserializer::from_str(json);
+        let seed = protocrap::serde::SerdeDeserialize::<packed::Flags::ProtoType>::new(&mut arena);
+        use serde::de::DeserializeSeed;
+        seed.deserialize(&mut deserializer)
+            .expect("json should deserialize")
+    };
+    let entry = with_map.overrides()[0];
+    assert!(entry.key() && !entry.value());
+    assert_json_roundtrip(&with_map);
+
+    // The pool reads the bits where the generated code put them
+    let options = LayoutOptions {
+        max_inline_message_size: 64,
+        reorder_fields: true,
+        bool_bits: true,
+        ..Default::default()
+    };
+    let mut pool = DescriptorPool::with_layout(&std::alloc::Global, options);
+    pool.add_file(packed::Flags::ProtoType::file_descriptor());
+    let table = pool.get_table("packed.Flags").expect("table should exist");
+    assert_eq!(table.size, <packed::Flags::ProtoType as Protobuf>::table().size);
+    let view = DynamicMessageRef {
+        object: ProtobufRef::as_object(&flags),
+        table,
+    };
+    assert_eq!(view.encode_vec::<32>().expect("msg should encode"), data);
+    let field = view.find_field_descriptor("f12").unwrap();
+    assert!(matches!(view.get_field(field), Some(Value::Bool(true))));
+    let field = view.find_field_descriptor("f2").unwrap();
+    assert!(view.get_field(field).is_none());
+}
+
 #[cfg(test)]
 mod chunked_tests {
     use super::*;
@@ -227,6 +937,10 @@ mod chunked_tests {
                 );
             }
         }
+        if depth > 0 && rng.gen_bool(0.3) {
+            let child = msg.lazy_child_mut(arena);
+            *child = make_random(arena, rng, depth - 1);
+        }
 
         msg
     }
@@ -306,6 +1020,16 @@ mod chunked_tests {
             }
         }
     }
+
+    #[test]
+    fn test_forward_encode_random_messages() {
+        for msg_seed in 0..50 {
+            let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+            let mut rng = StdRng::seed_from_u64(msg_seed);
+            let msg = make_random(&mut arena, &mut rng, 3);
+            crate::assert_forward_encode(&msg);
+        }
+    }
 }
 
 #[test]
@@ -13,12 +13,19 @@ use protocrap::google::protobuf::EnumDescriptorProto::ProtoType as EnumDescripto
 use protocrap::google::protobuf::FieldDescriptorProto::Type;
 use protocrap::google::protobuf::FileDescriptorProto::ProtoType as FileDescriptorProto;
 use protocrap::google::protobuf::FileDescriptorSet::ProtoType as FileDescriptorSet;
+use protocrap::wire::FieldKind;
+use protocrap::reflection::LayoutOptions;
+use protocrap::reflection::MessageLayout;
+use protocrap::reflection::MessageLayouts;
+use protocrap::reflection::is_lazy;
 use protocrap::reflection::is_repeated;
-use protocrap::reflection::needs_has_bit;
 use quote::{format_ident, quote};
 
 #[allow(dead_code)]
-pub(crate) fn generate_file_set(file_set: &FileDescriptorSet) -> Result<TokenStream> {
+pub(crate) fn generate_file_set(
+    file_set: &FileDescriptorSet,
+    options: LayoutOptions,
+) -> Result<TokenStream> {
     // Build a tree of packages to handle hierarchical namespaces properly
     // This avoids duplicate module declarations for packages like:
     //   - protobuf_test_messages.proto2
@@ -33,9 +40,14 @@ pub(crate) fn generate_file_set(file_set: &FileDescriptorSet) -> Result<TokenStr
 
     let mut root = PackageNode::default();
 
+    let mut layouts = MessageLayouts::new(options);
+    for &file in file_set.file() {
+        layouts.add_file(file);
+    }
+
     // Organize files into package tree
-    for file in file_set.file() {
-        let content = generate_file_content(file)?;
+    for &file in file_set.file() {
+        let content = generate_file_content(file, &mut layouts)?;
         let package = file.package();
 
         if package.is_empty() {
@@ -80,8 +92,62 @@ pub(crate) fn generate_file_set(file_set: &FileDescriptorSet) -> Result<TokenStr
     })
 }
 
+/// One line per message whose layout is smaller than with its fields in declaration
+/// order, followed by the total.
+#[allow(dead_code)]
+pub(crate) fn layout_summary(file_set: &FileDescriptorSet, options: LayoutOptions) -> String {
+    fn visit<'a>(
+        scope: &str,
+        message: &'a DescriptorProto,
+        layouts: &mut MessageLayouts<'a>,
+        savings: &mut Vec<(String, u32, u32)>,
+    ) {
+        let name = if scope.is_empty() {
+            message.name().to_string()
+        } else {
+            format!("{}.{}", scope, message.name())
+        };
+        for &nested in message.nested_type() {
+            visit(&name, nested, layouts, savings);
+        }
+        let layout = layouts.layout(message);
+        savings.push((name, layout.declared_size, layout.size));
+    }
+
+    let mut layouts = MessageLayouts::new(options);
+    let mut savings = Vec::new();
+    for &file in file_set.file() {
+        layouts.add_file(file);
+        for &message in file.message_type() {
+            visit(file.package(), message, &mut layouts, &mut savings);
+        }
+    }
+    savings.sort();
+
+    let mut summary = String::new();
+    let mut total = 0;
+    let mut improved = 0;
+    for (name, declared_size, size) in &savings {
+        if size < declared_size {
+            summary += &format!("{}: {} -> {} bytes\n", name, declared_size, size);
+            total += declared_size - size;
+            improved += 1;
+        }
+    }
+    summary += &format!(
+        "{} bytes saved in {} of {} messages\n",
+        total,
+        improved,
+        savings.len()
+    );
+    summary
+}
+
 /// Generate the content of a single file (without package module wrapping)
-fn generate_file_content(file: &FileDescriptorProto) -> Result<TokenStream> {
+fn generate_file_content<'a>(
+    file: &'a FileDescriptorProto,
+    layouts: &mut MessageLayouts<'a>,
+) -> Result<TokenStream> {
     let mut items = Vec::new();
 
     // Generate enums
@@ -90,10 +156,10 @@ fn generate_file_content(file: &FileDescriptorProto) -> Result<TokenStream> {
     }
 
     // Generate messages
-    for (idx, message) in file.message_type().iter().enumerate() {
+    for (idx, &message) in file.message_type().iter().enumerate() {
         let mut path = Vec::new();
         path.push(idx);
-        items.push(generate_message(message, file, path)?);
+        items.push(generate_message(message, file, path, layouts)?);
     }
 
     // Generate FILE_DESCRIPTOR_PROTO in a dedicated module to avoid name collisions
@@ -188,12 +254,13 @@ fn generate_enum(enum_desc: &&EnumDescriptorProto) -> Result<TokenStream> {
     })
 }
 
-fn generate_message(
-    message: &DescriptorProto,
+fn generate_message<'a>(
+    message: &'a DescriptorProto,
     file: &FileDescriptorProto,
     path: Vec<usize>,
+    layouts: &mut MessageLayouts<'a>,
 ) -> Result<TokenStream> {
-    let msg = generate_message_impl(message, file, path)?;
+    let msg = generate_message_impl(message, file, path, layouts)?;
     let name = format_ident!("{}", sanitize_field_name(message.name()));
 
     Ok(quote! {
@@ -207,18 +274,19 @@ fn generate_message(
     })
 }
 
-fn generate_message_impl(
-    message: &DescriptorProto,
+fn generate_message_impl<'a>(
+    message: &'a DescriptorProto,
     file: &FileDescriptorProto,
     path: Vec<usize>,
+    layouts: &mut MessageLayouts<'a>,
 ) -> Result<TokenStream> {
     // Nested types first
 
     let mut nested_items = Vec::new();
-    for (idx, nested) in message.nested_type().iter().enumerate() {
+    for (idx, &nested) in message.nested_type().iter().enumerate() {
         let mut nested_path = path.clone();
         nested_path.push(idx);
-        nested_items.push(generate_message(nested, file, nested_path)?);
+        nested_items.push(generate_message(nested, file, nested_path, layouts)?);
     }
 
     let nested_enums: Vec<_> = message
@@ -227,23 +295,21 @@ fn generate_message_impl(
         .map(generate_enum)
         .collect::<Result<Vec<_>, _>>()?;
 
+    let layout = layouts.layout(message);
+
     // Calculate has bits
-    let has_bit_fields: Vec<_> = message
-        .field()
-        .iter()
-        .filter(|f| needs_has_bit(f))
-        .collect();
+    let has_bit_fields = layout.has_bit_fields(message);
 
-    let has_bits_count = has_bit_fields.len();
-    let has_bits_words = has_bits_count.div_ceil(32);
+    let has_bits_words = layout.has_bits_words as usize;
 
-    // Struct fields
-    let struct_fields: Vec<_> = message
-        .field()
+    // Struct fields, in the order of the layout
+    let struct_fields: Vec<_> = layout
+        .field_order
         .iter()
-        .map(|&field| {
+        .map(|&i| {
+            let field = message.field()[i];
             let field_name = format_ident!("{}", sanitize_field_name(field.name()));
-            let field_type = rust_field_type_tokens(field);
+            let field_type = rust_field_type_tokens(field, &layout);
             (
                 field_name.clone(),
                 (field.number(), quote! { #field_name: #field_type }),
@@ -266,12 +332,12 @@ fn generate_message_impl(
         .collect();
 
     // Accessor methods
-    let accessors = generate_accessors(message, &has_bit_map)?;
+    let accessors = generate_accessors(message, &has_bit_map, &layout)?;
 
     // Protobuf trait impl
     let protobuf_impl = generate_protobuf_impl();
 
-    let table = tables::generate_table(message, &has_bit_map, Some(file.syntax()))?;
+    let table = tables::generate_table(message, &has_bit_map, Some(file.syntax()), &layout)?;
 
     // Build path to FILE_DESCRIPTOR_PROTO in the file-specific module
     let filename = std::path::Path::new(file.name())
@@ -505,14 +571,36 @@ fn parse_primitive_default(
 fn generate_accessors(
     message: &DescriptorProto,
     has_bit_map: &std::collections::HashMap<i32, usize>,
+    layout: &MessageLayout,
 ) -> Result<TokenStream> {
     let mut methods = Vec::new();
 
-    for &field in message.field() {
+    for (index, &field) in message.field().iter().enumerate() {
         let field_name = format_ident!("{}", sanitize_field_name(field.name()));
 
         if is_repeated(field) {
             // Repeated field accessor
+            if layout.field_kind(field) == FieldKind::RepeatedInlineMessage {
+                // Repeated message field with the elements stored inline
+                let msg_type = rust_type_tokens(field);
+                let field_name_mut = format_ident!("{}_mut", field_name);
+                let add_field_name = format_ident!("add_{}", field_name);
+                methods.push(quote! {
+                    pub const fn #field_name(&self) -> &[#msg_type::ProtoType] {
+                        self.#field_name.slice()
+                    }
+
+                    pub fn #field_name_mut(&mut self) -> &mut protocrap::containers::RepeatedField<#msg_type::ProtoType> {
+                        &mut self.#field_name
+                    }
+
+                    pub fn #add_field_name(&mut self, arena: &mut protocrap::arena::Arena) -> &mut #msg_type::ProtoType {
+                        self.#field_name.push(#msg_type::ProtoType::default(), arena);
+                        self.#field_name.last_mut().unwrap()
+                    }
+                });
+                continue;
+            }
             if field.r#type() == Some(Type::TYPE_MESSAGE)
                 || field.r#type() == Some(Type::TYPE_GROUP)
             {
@@ -542,7 +630,7 @@ fn generate_accessors(
                 });
                 continue;
             }
-            let element_type = rust_element_type_tokens(field);
+            let element_type = rust_element_type_tokens(field, layout);
             let field_name_mut = format_ident!("{}_mut", field_name);
             methods.push(quote! {
                 pub const fn #field_name(&self) -> &[#element_type] {
@@ -663,6 +751,56 @@ fn generate_accessors(
                         }
                     });
                 }
+                Type::TYPE_MESSAGE if layout.is_inline(field) => {
+                    // Embedded in the struct, present when its has bit is set
+                    let msg_type = rust_type_tokens(field);
+                    let field_name_mut = format_ident!("{}_mut", field_name);
+                    methods.push(quote! {
+                        pub const fn #field_name(&self) -> Option<&#msg_type::ProtoType> {
+                            if self.#has_name() {
+                                Some(&self.#field_name)
+                            } else {
+                                None
+                            }
+                        }
+
+                        pub fn #field_name_mut(&mut self, _arena: &mut protocrap::arena::Arena) -> &mut #msg_type::ProtoType {
+                            self.as_object_mut().set_has_bit(#has_bit);
+                            &mut self.#field_name
+                        }
+
+                        pub fn #clear_name(&mut self) {
+                            self.as_object_mut().clear_has_bit(#has_bit);
+                            self.#field_name = Default::default();
+                        }
+                    });
+                }
+                Type::TYPE_MESSAGE if is_lazy(field) => {
+                    let msg_type = rust_type_tokens(field);
+                    let field_name_mut = format_ident!("{}_mut", field_name);
+                    methods.push(quote! {
+                        pub const fn #has_name(&self) -> bool {
+                            !self.#field_name.0.is_null()
+                        }
+
+                        pub fn #field_name(&self) -> Option<&#msg_type::ProtoType> {
+                            let table = <#msg_type::ProtoType as protocrap::Protobuf>::table();
+                            self.#field_name
+                                .get(table)
+                                .map(|object| unsafe { &*(object as *const protocrap::base::Object as *const #msg_type::ProtoType) })
+                        }
+
+                        pub fn #field_name_mut(&mut self, arena: &mut protocrap::arena::Arena) -> &mut #msg_type::ProtoType {
+                            let table = <#msg_type::ProtoType as protocrap::Protobuf>::table();
+                            let object = self.#field_name.get_or_create(table, arena);
+                            unsafe { &mut *(object as *mut protocrap::base::Object as *mut #msg_type::ProtoType) }
+                        }
+
+                        pub fn #clear_name(&mut self) {
+                            self.#field_name = protocrap::base::LazyMessage(core::ptr::null_mut());
+                        }
+                    });
+                }
                 Type::TYPE_MESSAGE | Type::TYPE_GROUP => {
                     let msg_type = rust_type_tokens(field);
                     let field_name_mut = format_ident!("{}_mut", field_name);
@@ -696,6 +834,57 @@ fn generate_accessors(
                         }
                     });
                 }
+                Type::TYPE_BOOL if layout.field_kind(field) == FieldKind::BoolBit => {
+                    // The value is a bit of has_bits
+                    let bit = layout.offsets[index];
+                    let value = quote! {
+                        unsafe { (*(self as *const _ as *const protocrap::base::Object)).bit(#bit) }
+                    };
+                    let getter_impl = if let Some(default_tokens) = parse_primitive_default(field) {
+                        quote! {
+                            if self.#has_name() {
+                                #value
+                            } else {
+                                #default_tokens
+                            }
+                        }
+                    } else {
+                        value.clone()
+                    };
+
+                    methods.push(quote! {
+                        pub const fn #field_name(&self) -> bool {
+                            #getter_impl
+                        }
+
+                        pub const fn #optional_name(&self) -> Option<bool> {
+                            if self.#has_name() {
+                                Some(#value)
+                            } else {
+                                None
+                            }
+                        }
+
+                        pub fn #setter_name(&mut self, value: bool) {
+                            let object = self.as_object_mut();
+                            object.set_has_bit(#has_bit);
+                            object.set_bit(#bit, value);
+                        }
+
+                        pub fn #optional_setter_name(&mut self, value: Option<bool>) {
+                            match value {
+                                Some(v) => self.#setter_name(v),
+                                None => self.#clear_name(),
+                            }
+                        }
+
+                        pub fn #clear_name(&mut self) {
+                            let object = self.as_object_mut();
+                            object.clear_has_bit(#has_bit);
+                            object.set_bit(#bit, false);
+                        }
+                    });
+                }
                 Type::TYPE_ENUM => {
                     let enum_type = rust_type_tokens(field);
                     methods.push(quote! {
@@ -723,7 +912,7 @@ fn generate_accessors(
                 }
                 _ => {
                     // Scalar types
-                    let return_type = rust_element_type_tokens(field);
+                    let return_type = rust_element_type_tokens(field, layout);
 
                     // Parse default value if present
                     let default_value = parse_primitive_default(field);
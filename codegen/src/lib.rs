@@ -15,17 +15,21 @@ mod names;
 mod static_gen;
 mod tables;
 
+pub use protocrap::reflection::LayoutOptions;
+
 /// Generate Rust code from protobuf descriptor bytes
 pub fn generate(descriptor_bytes: &[u8]) -> Result<String> {
-    // Parse descriptor with prost
+    generate_with_options(descriptor_bytes, LayoutOptions::default())
+}
+
+/// Generate Rust code whose message structs are laid out according to `options`. A
+/// `DescriptorPool` reading these messages must be created with the same options.
+pub fn generate_with_options(descriptor_bytes: &[u8], options: LayoutOptions) -> Result<String> {
     let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
-    let mut file_set = FileDescriptorSet::default();
-    if !file_set.decode_flat::<100>(&mut arena, descriptor_bytes) {
-        return Err(anyhow::anyhow!("Failed to decode file descriptor set"));
-    }
+    let file_set = decode_file_set(descriptor_bytes, &mut arena)?;
 
     // Generate tokens
-    let tokens = generator::generate_file_set(&file_set)?;
+    let tokens = generator::generate_file_set(&file_set, options)?;
 
     let should_pretty_print = true;
     if should_pretty_print {
@@ -37,6 +41,25 @@ pub fn generate(descriptor_bytes: &[u8]) -> Result<String> {
     }
 }
 
+/// Report how many bytes the struct of each message saves with `options`, compared to
+/// its fields in declaration order.
+pub fn layout_summary(descriptor_bytes: &[u8], options: LayoutOptions) -> Result<String> {
+    let mut arena = protocrap::arena::Arena::new(&std::alloc::Global);
+    let file_set = decode_file_set(descriptor_bytes, &mut arena)?;
+    Ok(generator::layout_summary(&file_set, options))
+}
+
+fn decode_file_set(
+    descriptor_bytes: &[u8],
+    arena: &mut protocrap::arena::Arena,
+) -> Result<FileDescriptorSet> {
+    let mut file_set = FileDescriptorSet::default();
+    if !file_set.decode_flat::<100>(arena, descriptor_bytes) {
+        return Err(anyhow::anyhow!("Failed to decode file descriptor set"));
+    }
+    Ok(file_set)
+}
+
 pub fn generate_proto(out_dir: &str, proto_file: &str, output_name: &str) -> Result<()> {
     let desc_file = format!("{}/temp.desc", out_dir);
     let output_file = format!("{}/{}", out_dir, output_name);
@@ -14,7 +14,9 @@ mod static_gen;
 mod tables;
 
 fn main() -> Result<(), Box<dyn std::error::Error>> {
-    let args: Vec<_> = std::env::args().collect();
+    let mut args: Vec<_> = std::env::args().collect();
+    let reorder_fields = args.iter().any(|arg| arg == "--reorder-fields");
+    args.retain(|arg| arg != "--reorder-fields");
 
     if args.len() < 2 {
         print_usage(&args[0]);
@@ -35,7 +37,17 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
     println!("✅ Read descriptor ({} bytes)", descriptor_bytes.len());
 
     // Generate code
-    let code = protocrap_codegen::generate(&descriptor_bytes)?;
+    let options = protocrap_codegen::LayoutOptions {
+        reorder_fields,
+        ..Default::default()
+    };
+    let code = protocrap_codegen::generate_with_options(&descriptor_bytes, options)?;
+    if reorder_fields {
+        eprint!(
+            "{}",
+            protocrap_codegen::layout_summary(&descriptor_bytes, options)?
+        );
+    }
 
     // Write output
     if args.len() > 2 {
@@ -54,13 +66,17 @@ fn print_usage(program: &str) {
     eprintln!("Protocrap Code Generator");
     eprintln!();
     eprintln!("USAGE:");
-    eprintln!("  {} <descriptor.pb> [output.rs]", program);
+    eprintln!("  {} [--reorder-fields] <descriptor.pb> [output.rs]", program);
     eprintln!("  {} - < descriptor.pb > output.rs", program);
     eprintln!();
     eprintln!("ARGUMENTS:");
     eprintln!("  descriptor.pb   FileDescriptorSet from protoc");
     eprintln!("  output.rs       Output Rust file (default: stdout)");
     eprintln!();
+    eprintln!("OPTIONS:");
+    eprintln!("  --reorder-fields  Order struct fields to minimize padding, and report the");
+    eprintln!("                    bytes saved per message");
+    eprintln!();
     eprintln!("EXAMPLE:");
     eprintln!("  protoc --descriptor_set_out=desc.pb --include_imports my.proto");
     eprintln!("  {} desc.pb my.pc.rs", program);
@@ -4,6 +4,7 @@ use super::protocrap;
 use proc_macro2::TokenStream;
 use protocrap::google::protobuf::FieldDescriptorProto::ProtoType as FieldDescriptorProto;
 use protocrap::google::protobuf::FieldDescriptorProto::Type;
+use protocrap::reflection::MessageLayout;
 use quote::{format_ident, quote};
 
 const RUST_KEYWORDS: &[&str] = &[
@@ -32,10 +33,10 @@ pub fn sanitize_module_name(name: &str) -> String {
     }
 }
 
-pub fn rust_field_type_tokens(field: &FieldDescriptorProto) -> TokenStream {
+pub fn rust_field_type_tokens(field: &FieldDescriptorProto, layout: &MessageLayout) -> TokenStream {
     use protocrap::google::protobuf::FieldDescriptorProto::Label;
 
-    let element = rust_element_type_tokens(field);
+    let element = rust_element_type_tokens(field, layout);
     if field.label().unwrap() == Label::LABEL_REPEATED {
         quote! { protocrap::containers::RepeatedField<#element> }
     } else {
@@ -43,8 +44,19 @@ pub fn rust_field_type_tokens(field: &FieldDescriptorProto) -> TokenStream {
     }
 }
 
-pub fn rust_element_type_tokens(field: &FieldDescriptorProto) -> TokenStream {
+pub fn rust_element_type_tokens(field: &FieldDescriptorProto, layout: &MessageLayout) -> TokenStream {
+    let kind = layout.field_kind(field);
     match field.r#type().unwrap() {
+        Type::TYPE_MESSAGE if protocrap::reflection::is_lazy(field) => {
+            quote! { protocrap::base::LazyMessage }
+        }
+        Type::TYPE_MESSAGE
+            if kind == protocrap::wire::FieldKind::RepeatedInlineMessage
+                || kind == protocrap::wire::FieldKind::InlineMessage =>
+        {
+            let msg_type = rust_type_tokens(field);
+            quote! { #msg_type::ProtoType }
+        }
         Type::TYPE_MESSAGE | Type::TYPE_GROUP => quote! { protocrap::base::Message },
         Type::TYPE_INT32 | Type::TYPE_SINT32 | Type::TYPE_SFIXED32 => quote! { i32 },
         Type::TYPE_INT64 | Type::TYPE_SINT64 | Type::TYPE_SFIXED64 => quote! { i64 },
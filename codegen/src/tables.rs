@@ -5,7 +5,8 @@ use proc_macro2::TokenStream;
 use protocrap::google::protobuf::DescriptorProto::ProtoType as DescriptorProto;
 use protocrap::google::protobuf::FieldDescriptorProto::ProtoType as FieldDescriptorProto;
 
-use protocrap::reflection::{calculate_tag_with_syntax, is_message};
+use protocrap::reflection::{MessageLayout, calculate_tag_with_syntax, is_message};
+use protocrap::wire::FieldKind;
 use quote::{format_ident, quote};
 
 fn generate_aux_entries(
@@ -37,6 +38,7 @@ fn generate_encoding_entries(
     has_bit_map: &std::collections::HashMap<i32, usize>,
     aux_index_map: &std::collections::HashMap<i32, usize>,
     syntax: Option<&str>,
+    layout: &MessageLayout,
 ) -> Result<Vec<TokenStream>> {
     let num_encode_entries = message.field().len();
     let num_aux_entries = aux_index_map.len();
@@ -55,9 +57,9 @@ fn generate_encoding_entries(
     let num_decode_entries = max_field_number as usize + 1;
 
     let entries: Vec<_> = message.field().iter().map(|field| {
-        let field_name = format_ident!("{}", sanitize_field_name(field.name()));
+        let offset = field_offset_tokens(message, field, layout);
         let has_bit = has_bit_map.get(&field.number()).copied().unwrap_or(0) as u8;
-        let kind = field_kind_tokens(field);
+        let kind = field_kind_tokens(field, layout);
         let encoded_tag = calculate_tag_with_syntax(field, syntax);
 
         if is_message(field) {
@@ -80,7 +82,7 @@ fn generate_encoding_entries(
                 protocrap::encoding::TableEntry {
                     has_bit: #has_bit,
                     kind: #kind,
-                    offset: core::mem::offset_of!(ProtoType, #field_name) as u16,
+                    offset: #offset as u16,
                     encoded_tag: #encoded_tag,
                 }
             }
@@ -94,6 +96,7 @@ fn generate_decoding_table(
     message: &DescriptorProto,
     has_bit_map: &std::collections::HashMap<i32, usize>,
     aux_index_map: &std::collections::HashMap<i32, usize>,
+    layout: &MessageLayout,
 ) -> Result<Vec<TokenStream>> {
     // Calculate masked table parameters
     let max_field_number = message
@@ -116,28 +119,27 @@ fn generate_decoding_table(
     // Generate entry table
     let entries: Vec<_> = (0..=max_field_number).map(|field_number| {
         if let Some(field) = message.field().iter().find(|f| f.number() == field_number as i32) {
-            let field_name = format_ident!("{}", sanitize_field_name(field.name()));
+            let offset = field_offset_tokens(message, field, layout);
 
-            let field_kind = field_kind_tokens(field);
+            let field_kind = field_kind_tokens(field, layout);
+            let has_bit = has_bit_map.get(&field_number).copied().unwrap_or(0) as u32;
 
             if is_message(field) {
                 let aux_index = *aux_index_map.get(&field_number).unwrap();
-                // Message field - offset points to aux entry
+                // Message field - offset points to aux entry, has bit only used when inline
                 quote! { protocrap::decoding::TableEntry::new(
                     #field_kind,
-                    0,
+                    #has_bit,
                     core::mem::offset_of!(protocrap::tables::TableWithEntries<#num_encode_entries, #num_decode_entries, #num_aux_entries>, aux_entries) + 
                     #aux_index * core::mem::size_of::<protocrap::tables::AuxTableEntry>() - 
                     core::mem::offset_of!(protocrap::tables::TableWithEntries<#num_encode_entries, #num_decode_entries, #num_aux_entries>, table)
                 ) }
             } else {
-                let has_bit = has_bit_map.get(&field_number).copied().unwrap_or(0) as u32;
-
                 quote! {
                     protocrap::decoding::TableEntry::new(
                         #field_kind,
                         #has_bit,
-                        core::mem::offset_of!(ProtoType, #field_name)
+                        #offset
                     )
                 }
             }
@@ -149,16 +151,59 @@ fn generate_decoding_table(
     Ok(entries)
 }
 
+fn generate_fast_table(
+    message: &DescriptorProto,
+    has_bit_map: &std::collections::HashMap<i32, usize>,
+    syntax: Option<&str>,
+    layout: &MessageLayout,
+) -> Vec<TokenStream> {
+    let mut slots = vec![None; protocrap::decoding::NUM_FAST_ENTRIES];
+    let mut fields: Vec<_> = message.field().iter().collect();
+    fields.sort_by_key(|f| f.number());
+    // Lowest field number wins a contested slot
+    for field in fields {
+        let encoded_tag = calculate_tag_with_syntax(field, syntax);
+        let kind = layout.field_kind(field);
+        if let Some(slot) = protocrap::decoding::fast_slot(kind, encoded_tag) {
+            if slots[slot].is_none() {
+                slots[slot] = Some((field, encoded_tag));
+            }
+        }
+    }
+
+    slots.into_iter().map(|slot| {
+        if let Some((field, encoded_tag)) = slot {
+            let offset = field_offset_tokens(message, field, layout);
+            let field_kind = field_kind_tokens(field, layout);
+            let has_bit = has_bit_map.get(&field.number()).copied().unwrap_or(0) as u32;
+            quote! {
+                protocrap::decoding::FastEntry::new(
+                    #encoded_tag,
+                    protocrap::decoding::TableEntry::new(
+                        #field_kind,
+                        #has_bit,
+                        #offset
+                    )
+                )
+            }
+        } else {
+            quote! { protocrap::decoding::FastEntry::EMPTY }
+        }
+    }).collect()
+}
+
 pub(crate) fn generate_table(
     message: &DescriptorProto,
     has_bit_map: &std::collections::HashMap<i32, usize>,
     syntax: Option<&str>,
+    layout: &MessageLayout,
 ) -> Result<TokenStream> {
     let mut aux_index_map = std::collections::HashMap::<i32, usize>::new();
     let aux_entries = generate_aux_entries(message, &mut aux_index_map)?;
 
-    let encoding_entries = generate_encoding_entries(message, has_bit_map, &aux_index_map, syntax)?;
-    let decoding_entries = generate_decoding_table(message, has_bit_map, &aux_index_map)?;
+    let encoding_entries = generate_encoding_entries(message, has_bit_map, &aux_index_map, syntax, layout)?;
+    let decoding_entries = generate_decoding_table(message, has_bit_map, &aux_index_map, layout)?;
+    let fast_entries = generate_fast_table(message, has_bit_map, syntax, layout);
 
     let num_encode_entries = encoding_entries.len();
     let num_decode_entries = decoding_entries.len();
@@ -179,6 +224,9 @@ pub(crate) fn generate_table(
                 size: core::mem::size_of::<ProtoType>() as u16,
                 descriptor: ProtoType::descriptor_proto(),
             },
+            fast_entries: [
+                #(#fast_entries),*
+            ],
             decode_entries: [
                 #(#decoding_entries),*
             ],
@@ -189,8 +237,24 @@ pub(crate) fn generate_table(
     })
 }
 
-fn field_kind_tokens(field: &&FieldDescriptorProto) -> TokenStream {
-    let kind = protocrap::reflection::field_kind_tokens(field);
+// Offset of the field in the struct, or the index of its bit for bools stored as bits
+fn field_offset_tokens(
+    message: &DescriptorProto,
+    field: &FieldDescriptorProto,
+    layout: &MessageLayout,
+) -> TokenStream {
+    if layout.field_kind(field) == FieldKind::BoolBit {
+        let index = message.field().iter().position(|f| f.number() == field.number()).unwrap();
+        let bit = layout.offsets[index] as usize;
+        quote! { #bit }
+    } else {
+        let field_name = format_ident!("{}", sanitize_field_name(field.name()));
+        quote! { core::mem::offset_of!(ProtoType, #field_name) }
+    }
+}
+
+fn field_kind_tokens(field: &FieldDescriptorProto, layout: &MessageLayout) -> TokenStream {
+    let kind = layout.field_kind(field);
     let ident = format_ident!("{kind:?}");
     quote! { protocrap::wire::FieldKind::#ident }
 }
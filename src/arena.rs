@@ -1,6 +1,11 @@
-use core::alloc::{Allocator, Layout};
+use core::alloc::{AllocError, Allocator, Layout};
+use core::cell::UnsafeCell;
+use core::mem::MaybeUninit;
 use core::ptr;
 use core::ptr::NonNull;
+use core::sync::atomic::{AtomicUsize, Ordering};
+
+use crate::containers::RepeatedField;
 
 // Arena allocates memory for protobuf objects. Which can be freed all at once.
 // This is useful for short lived objects that are created and destroyed together.
@@ -14,6 +19,146 @@ pub struct Arena<'a> {
     cursor: *mut u8,
     end: *mut u8,
     allocator: &'a dyn core::alloc::Allocator,
+    nested: *mut NestedArena,
+    // Blocks kept by reset for reuse, largest first
+    free: *mut MemBlock,
+    // Bytes of the blocks on the free list
+    retained: usize,
+    // Caller provided buffer that is used before any block, restored by reset
+    initial: *mut u8,
+    initial_end: *mut u8,
+    retain_limit: usize,
+    resident_limit: usize,
+    memory_limit: usize,
+    // Limit shared with nested arenas, created with the first one when there is a limit
+    budget: *const Budget,
+    policy: GrowthPolicy,
+    stats: ArenaStats,
+    // Memory handed back with recycle, forgotten by reset and rollback
+    recycled: *mut RecycleBin,
+}
+
+/// How an arena sizes the blocks it requests from its allocator.
+#[derive(Clone, Copy, Debug)]
+pub struct GrowthPolicy {
+    /// Size of the first block.
+    pub initial_block_size: usize,
+    /// Each new block is this many times the size of the previous one.
+    pub growth_factor: usize,
+    /// Blocks stop growing at this size.
+    pub max_block_size: usize,
+    /// An allocation that does not fit the current block gets a block of its own if at
+    /// least this many bytes are left in the current block, so they are not wasted.
+    pub dedicated_threshold: usize,
+}
+
+impl GrowthPolicy {
+    pub const DEFAULT: GrowthPolicy = GrowthPolicy {
+        initial_block_size: DEFAULT_BLOCK_SIZE,
+        growth_factor: 2,
+        max_block_size: MAX_BLOCK_SIZE,
+        dedicated_threshold: 512,
+    };
+}
+
+impl Default for GrowthPolicy {
+    fn default() -> Self {
+        Self::DEFAULT
+    }
+}
+
+/// Counters for tuning the growth policy of an arena.
+#[derive(Clone, Copy, Debug, Default)]
+pub struct ArenaStats {
+    /// Bytes currently held from the allocator, including blocks retained by `reset`.
+    pub bytes_allocated: usize,
+    /// Bytes left unused at the end of blocks that were replaced by a new block.
+    pub wasted_bytes: usize,
+    /// Number of allocations that got a block of their own.
+    pub dedicated_allocations: usize,
+}
+
+/// State of an arena returned by `Arena::checkpoint`.
+#[derive(Clone, Copy)]
+pub struct Checkpoint {
+    current: *mut MemBlock,
+    // Block behind current, dedicated blocks are inserted in between
+    dedicated: *mut MemBlock,
+    cursor: *mut u8,
+    end: *mut u8,
+    nested: *mut NestedArena,
+    budget: *const Budget,
+}
+
+// The memory limit of an arena, shared with the arenas nested in it, so what lazy fields
+// allocate on access counts against the limit of the arena they were decoded into. Lives
+// in the memory of the arena that created it. Atomic, as lazy fields may be decoded on
+// several threads at once.
+struct Budget {
+    limit: AtomicUsize,
+    used: AtomicUsize,
+}
+
+impl Budget {
+    fn try_charge(&self, bytes: usize) -> Result<(), AllocError> {
+        let limit = self.limit.load(Ordering::Relaxed);
+        self.used
+            .fetch_update(Ordering::Relaxed, Ordering::Relaxed, |used| {
+                used.checked_add(bytes).filter(|&used| used <= limit)
+            })
+            .map(|_| ())
+            .map_err(|_| AllocError)
+    }
+
+    fn remaining(&self) -> usize {
+        let used = self.used.load(Ordering::Relaxed);
+        self.limit.load(Ordering::Relaxed).saturating_sub(used)
+    }
+}
+
+// An arena that lives in the memory of a parent arena and is dropped together with it.
+// It provides storage that is filled in behind a shared reference, like lazily decoded
+// submessages, without tying the storage to the lifetime of a borrow.
+pub struct NestedArena {
+    arena: UnsafeCell<Arena<'static>>,
+    next: *mut NestedArena,
+}
+
+impl NestedArena {
+    /// # Safety
+    /// The caller must have exclusive access to the nested arena for the lifetime of the
+    /// returned reference.
+    #[allow(clippy::mut_from_ref)]
+    pub(crate) unsafe fn get(&self) -> &mut Arena<'static> {
+        unsafe { &mut *self.arena.get() }
+    }
+}
+
+/// An arena that is moved to another thread. Only created for arenas whose allocator is
+/// Sync, and only arenas with that same allocator may be fused into it.
+#[cfg(feature = "std")]
+pub(crate) struct SendArena<'a>(pub(crate) Arena<'a>);
+
+// Safety: The allocator is Sync and the arena owns its memory
+#[cfg(feature = "std")]
+unsafe impl Send for SendArena<'_> {}
+
+/// Blocks retained by an arena, sorted largest first.
+#[cfg(feature = "std")]
+pub(crate) struct BlockChain {
+    head: *mut MemBlock,
+    pub(crate) bytes: usize,
+}
+
+// Safety: The chain owns its blocks, which are only touched by one arena at a time
+#[cfg(feature = "std")]
+unsafe impl Send for BlockChain {}
+
+// Recycled memory with the same key, lives in the memory of the arena
+struct RecycleBin {
+    key: usize,
+    items: RepeatedField<*mut u8>,
+    next: *mut RecycleBin,
 }
 
 // Mem block is a block of contiguous memory allocated from the allocator
@@ -24,6 +169,8 @@ struct MemBlock {
 
 const DEFAULT_BLOCK_SIZE: usize = 8 * 1024; // 8KB initial block
 const MAX_BLOCK_SIZE: usize = 1024 * 1024; // 1MB max block
+const DEFAULT_RETAIN_LIMIT: usize = MAX_BLOCK_SIZE;
+const DEFAULT_RESIDENT_LIMIT: usize = 256 * 1024;
 
 impl<'a> Arena<'a> {
     /// Create a new arena with the given allocator
@@ -33,9 +180,396 @@ impl<'a> Arena<'a> {
             cursor: ptr::null_mut(),
             end: ptr::null_mut(),
             allocator,
+            nested: ptr::null_mut(),
+            free: ptr::null_mut(),
+            retained: 0,
+            initial: ptr::null_mut(),
+            initial_end: ptr::null_mut(),
+            retain_limit: DEFAULT_RETAIN_LIMIT,
+            resident_limit: DEFAULT_RESIDENT_LIMIT,
+            memory_limit: usize::MAX,
+            budget: ptr::null(),
+            policy: GrowthPolicy::DEFAULT,
+            stats: ArenaStats::default(),
+            recycled: ptr::null_mut(),
+        }
+    }
+
+    /// Create a new arena with the given allocator and growth policy
+    pub fn with_policy(allocator: &'a dyn Allocator, policy: GrowthPolicy) -> Self {
+        let mut arena = Self::new(allocator);
+        arena.set_growth_policy(policy);
+        arena
+    }
+
+    /// Sets the growth policy for blocks allocated from now on.
+    pub fn set_growth_policy(&mut self, policy: GrowthPolicy) {
+        assert!(
+            policy.growth_factor >= 1,
+            "Growth factor must be at least 1"
+        );
+        self.policy = policy;
+    }
+
+    /// Create an arena that allocates from `buffer` first, e.g. a stack array or a
+    /// thread-local scratch buffer, and only falls back to `allocator` once the buffer is
+    /// full. Pass `&NoHeap` for an arena that never touches the heap.
+    pub fn with_initial_buffer(
+        buffer: &'a mut [MaybeUninit<u8>],
+        allocator: &'a dyn Allocator,
+    ) -> Self {
+        let range = buffer.as_mut_ptr_range();
+        let mut arena = Self::new(allocator);
+        arena.initial = range.start as *mut u8;
+        arena.initial_end = range.end as *mut u8;
+        arena.cursor = arena.initial;
+        arena.end = arena.initial_end;
+        arena
+    }
+
+    /// Sets how much memory `reset` keeps. Blocks are retained largest first, up to
+    /// `retain_limit` bytes. Where supported, the pages of retained blocks beyond the
+    /// first `resident_limit` bytes are returned to the OS, but stay allocated.
+    pub fn set_retention(&mut self, retain_limit: usize, resident_limit: usize) {
+        self.retain_limit = retain_limit;
+        self.resident_limit = resident_limit;
+    }
+
+    /// Caps the memory the arena holds from its allocator, including blocks retained for
+    /// reuse. Allocations beyond the limit fail: `try_alloc_raw` returns an error, which
+    /// makes a decode fail, and the infallible allocation functions panic. Nested arenas,
+    /// which decode lazy fields on access, share the limit: what they allocate counts
+    /// against it as well.
+    pub fn set_memory_limit(&mut self, limit: usize) {
+        self.memory_limit = limit;
+        if let Some(budget) = unsafe { self.budget.as_ref() } {
+            budget.limit.store(limit, Ordering::Relaxed);
         }
     }
 
+    /// Frees everything allocated from the arena, like dropping it and creating a new
+    /// one, but keeps blocks for reuse according to `set_retention`. A loop that decodes
+    /// into a reset arena stops calling the allocator once the retained blocks fit a
+    /// request.
+    pub fn reset(&mut self) {
+        unsafe {
+            self.drop_nested();
+            // The budget lives in our blocks. Only the arena that created it is reset,
+            // nested arenas are dropped with their parent.
+            self.budget = ptr::null();
+
+            // Sort all blocks by size, largest first
+            let mut sorted: *mut MemBlock = ptr::null_mut();
+            for list in [self.current, self.free] {
+                let mut block = list;
+                while !block.is_null() {
+                    let prev = (*block).prev;
+                    insert_sorted(&mut sorted, block);
+                    block = prev;
+                }
+            }
+
+            let mut retained = 0;
+            let mut link = &mut self.free;
+            let mut block = sorted;
+            while !block.is_null() {
+                let prev = (*block).prev;
+                let size = (*block).layout.size();
+                if retained + size <= self.retain_limit {
+                    if retained + size > self.resident_limit {
+                        let start = (block as *mut u8).add(
+                            self.resident_limit
+                                .saturating_sub(retained)
+                                .max(size_of::<MemBlock>()),
+                        );
+                        release_pages(start, (block as *mut u8).add(size));
+                    }
+                    retained += size;
+                    *link = block;
+                    link = &mut (*block).prev;
+                } else {
+                    self.stats.bytes_allocated -= size;
+                    self.allocator
+                        .deallocate(NonNull::new_unchecked(block as *mut u8), (*block).layout);
+                }
+                block = prev;
+            }
+            *link = ptr::null_mut();
+            self.retained = retained;
+
+            self.current = ptr::null_mut();
+            self.cursor = self.initial;
+            self.end = self.initial_end;
+            self.recycled = ptr::null_mut();
+        }
+    }
+
+    /// Marks the current state of the arena, to return to with `rollback`.
+    pub fn checkpoint(&self) -> Checkpoint {
+        Checkpoint {
+            current: self.current,
+            dedicated: if self.current.is_null() {
+                ptr::null_mut()
+            } else {
+                unsafe { (*self.current).prev }
+            },
+            cursor: self.cursor,
+            end: self.end,
+            nested: self.nested,
+            budget: self.budget,
+        }
+    }
+
+    /// Frees everything allocated since `checkpoint` was taken, including dedicated
+    /// blocks and nested arenas. Released blocks are kept for reuse up to the retain limit
+    /// of `set_retention`, so retrying a failed decode does not call the allocator again.
+    /// Recycled memory is forgotten, as it may have been allocated after the checkpoint.
+    ///
+    /// # Safety
+    /// Memory allocated after the checkpoint must no longer be used, and the arena must
+    /// not have been reset since the checkpoint was taken.
+    pub unsafe fn rollback(&mut self, checkpoint: Checkpoint) {
+        unsafe {
+            // Nested arenas are pushed on the front of the list, like blocks
+            while self.nested != checkpoint.nested {
+                let next = (*self.nested).next;
+                ptr::drop_in_place((*self.nested).arena.get());
+                self.nested = next;
+            }
+            // A budget created since the checkpoint lives in a block that is released
+            self.budget = checkpoint.budget;
+
+            // Blocks started since the checkpoint, with their dedicated blocks, come before
+            // the block that was current. Dedicated blocks allocated while it was still
+            // current are linked right behind it.
+            let mut block = self.current;
+            while block != checkpoint.current {
+                let prev = (*block).prev;
+                self.release_block(block);
+                block = prev;
+            }
+            if !block.is_null() {
+                let mut dedicated = (*block).prev;
+                while dedicated != checkpoint.dedicated {
+                    let prev = (*dedicated).prev;
+                    self.release_block(dedicated);
+                    dedicated = prev;
+                }
+                (*block).prev = checkpoint.dedicated;
+            }
+
+            self.current = checkpoint.current;
+            self.cursor = checkpoint.cursor;
+            self.end = checkpoint.end;
+            self.recycled = ptr::null_mut();
+        }
+    }
+
+    // Puts a block that is no longer in use on the free list, or frees it if that would
+    // exceed the retain limit.
+    unsafe fn release_block(&mut self, block: *mut MemBlock) {
+        unsafe {
+            let layout = (*block).layout;
+            if self.retained + layout.size() <= self.retain_limit {
+                insert_sorted(&mut self.free, block);
+                self.retained += layout.size();
+            } else {
+                self.uncharge(layout.size());
+                self.allocator
+                    .deallocate(NonNull::new_unchecked(block as *mut u8), layout);
+            }
+        }
+    }
+
+    /// Resets the arena and takes the blocks it retained, so they can be handed to
+    /// another arena with `add_retained`.
+    #[cfg(feature = "std")]
+    pub(crate) fn take_retained(&mut self) -> BlockChain {
+        self.reset();
+        let head = core::mem::replace(&mut self.free, ptr::null_mut());
+        let bytes = core::mem::take(&mut self.retained);
+        self.uncharge(bytes);
+        BlockChain { head, bytes }
+    }
+
+    /// Whether the arena allocates from `allocator`. Allocators of different types compare
+    /// unequal, even when they are zero sized.
+    #[cfg(feature = "std")]
+    pub(crate) fn uses_allocator(&self, allocator: &dyn Allocator) -> bool {
+        ptr::eq(self.allocator, allocator)
+    }
+
+    /// Allocates memory that another arena uses as a block. That arena counts the memory
+    /// as allocated, so this arena stops counting it. Only for arenas that are dropped
+    /// without being reset.
+    #[cfg(feature = "std")]
+    pub(crate) fn try_lend(&mut self, layout: Layout) -> Result<NonNull<u8>, AllocError> {
+        let ptr = self.try_alloc_raw(layout)?;
+        self.uncharge(layout.size());
+        Ok(ptr)
+    }
+
+    /// Gives a new arena blocks for reuse, as if it had retained them itself.
+    ///
+    /// # Safety
+    /// The blocks must have been taken from an arena with the same allocator.
+    #[cfg(feature = "std")]
+    pub(crate) unsafe fn add_retained(&mut self, chain: BlockChain) {
+        assert!(self.free.is_null(), "Arena already has retained blocks");
+        self.free = chain.head;
+        self.retained = chain.bytes;
+        self.charge(chain.bytes);
+    }
+
+    unsafe fn drop_nested(&mut self) {
+        // Nested arenas live in our blocks, drop them before the blocks are freed
+        let mut nested = self.nested;
+        while !nested.is_null() {
+            unsafe {
+                let next = (*nested).next;
+                ptr::drop_in_place((*nested).arena.get());
+                nested = next;
+            }
+        }
+        self.nested = ptr::null_mut();
+    }
+
+    /// Initializes `nested` as an empty arena with the same allocator and growth policy as
+    /// this arena, sharing its memory limit. It first allocates from
+    /// `initial_size` bytes of this arena, at most an initial block, so a small nested
+    /// arena does not need a block of its own. It is dropped when this arena is dropped.
+    ///
+    /// # Safety
+    /// `nested` must point to uninitialized memory allocated from this arena.
+    pub(crate) unsafe fn init_nested(
+        &mut self,
+        nested: *mut NestedArena,
+        initial_size: usize,
+    ) -> Result<(), AllocError> {
+        let initial_size = initial_size
+            .min(self.policy.initial_block_size)
+            .next_multiple_of(align_of::<u64>());
+        let initial = if initial_size == 0 {
+            ptr::null_mut()
+        } else {
+            self.try_alloc_raw(Layout::from_size_align(initial_size, align_of::<u64>()).unwrap())?
+                .as_ptr()
+        };
+        // SAFETY: The nested arena is dropped before this arena, so it cannot outlive the
+        // allocator.
+        let allocator: &'static dyn Allocator = unsafe { core::mem::transmute(self.allocator) };
+        if self.budget.is_null() && self.memory_limit != usize::MAX {
+            let budget = self.try_alloc_raw(Layout::new::<Budget>())?.as_ptr() as *mut Budget;
+            unsafe {
+                budget.write(Budget {
+                    limit: AtomicUsize::new(self.memory_limit),
+                    used: AtomicUsize::new(self.stats.bytes_allocated),
+                })
+            };
+            self.budget = budget;
+        }
+        let mut arena = Arena::with_policy(allocator, self.policy);
+        arena.budget = self.budget;
+        arena.initial = initial;
+        arena.initial_end = unsafe { initial.add(initial_size) };
+        arena.cursor = arena.initial;
+        arena.end = arena.initial_end;
+        unsafe {
+            nested.write(NestedArena {
+                arena: UnsafeCell::new(arena),
+                next: self.nested,
+            })
+        };
+        self.nested = nested;
+        Ok(())
+    }
+
+    /// Takes over the memory of `other` in O(1), without copying. Everything allocated
+    /// from `other` stays valid for as long as this arena, so subtrees built in separate
+    /// arenas can be linked into one message.
+    pub fn fuse(&mut self, other: Arena<'a>) {
+        if self.try_fuse(other).is_err() {
+            panic!("Allocation failed");
+        }
+    }
+
+    /// Like `fuse`, but hands `other` back when this arena cannot allocate the memory to
+    /// keep track of it, e.g. at the memory limit.
+    pub fn try_fuse(&mut self, other: Arena<'a>) -> Result<(), Arena<'a>> {
+        let Ok(nested) = self.try_alloc_raw(Layout::new::<NestedArena>()) else {
+            return Err(other);
+        };
+        let nested = nested.as_ptr() as *mut NestedArena;
+        // SAFETY: The allocator of other lives for 'a like ours, and the nested arena is
+        // dropped before this arena, like the ones from init_nested.
+        let other: Arena<'static> = unsafe { core::mem::transmute(other) };
+        unsafe {
+            nested.write(NestedArena {
+                arena: UnsafeCell::new(other),
+                next: self.nested,
+            })
+        };
+        self.nested = nested;
+        Ok(())
+    }
+
+    /// Keeps memory that is no longer used for reuse, `take_recycled` with the same key
+    /// returns it instead of allocating anew. The caller decides what a key stands for,
+    /// e.g. the table of a cleared message object. Recycling is best effort: the memory
+    /// is just left unused if the arena cannot keep track of it.
+    ///
+    /// # Safety
+    /// `ptr` must be owned by this arena and no longer be used.
+    pub(crate) unsafe fn recycle(&mut self, key: usize, ptr: *mut u8) {
+        unsafe {
+            let mut bin = self.recycled;
+            while !bin.is_null() && (*bin).key != key {
+                bin = (*bin).next;
+            }
+            if bin.is_null() {
+                let Ok(new_bin) = self.try_alloc_raw(Layout::new::<RecycleBin>()) else {
+                    return;
+                };
+                bin = new_bin.as_ptr() as *mut RecycleBin;
+                bin.write(RecycleBin {
+                    key,
+                    items: RepeatedField::new(),
+                    next: self.recycled,
+                });
+                self.recycled = bin;
+            }
+            let _ = (*bin).items.try_push(ptr, self);
+        }
+    }
+
+    /// Returns memory recycled with `key`, most recently recycled first.
+    #[inline]
+    pub(crate) fn take_recycled(&mut self, key: usize) -> Option<*mut u8> {
+        if self.recycled.is_null() {
+            return None;
+        }
+        self.take_recycled_outlined(key)
+    }
+
+    /// Whether memory was recycled since the arena was last reset or rolled back.
+    pub(crate) fn is_recycling(&self) -> bool {
+        !self.recycled.is_null()
+    }
+
+    #[inline(never)]
+    fn take_recycled_outlined(&mut self, key: usize) -> Option<*mut u8> {
+        let mut bin = self.recycled;
+        while !bin.is_null() {
+            unsafe {
+                if (*bin).key == key {
+                    return (*bin).items.pop();
+                }
+                bin = (*bin).next;
+            }
+        }
+        None
+    }
+
     /// Allocate uninitialized memory for type T, returning a raw pointer
     pub fn alloc<T>(&mut self) -> *mut T {
         let layout = Layout::new::<T>();
@@ -62,6 +596,13 @@ impl<'a> Arena<'a> {
     /// Allocate raw memory with given size and alignment (uninitialized)
     #[inline]
     pub fn alloc_raw(&mut self, layout: Layout) -> NonNull<u8> {
+        self.try_alloc_raw(layout).expect("Allocation failed")
+    }
+
+    /// Like `alloc_raw`, but returns an error when the allocator fails or the memory
+    /// limit is reached.
+    #[inline]
+    pub fn try_alloc_raw(&mut self, layout: Layout) -> Result<NonNull<u8>, AllocError> {
         let size = layout.size();
         let align = layout.align();
 
@@ -75,34 +616,57 @@ impl<'a> Arena<'a> {
         if core::hint::likely(available >= size as isize) {
             // Fits in current block - use it regardless of size
             self.cursor = unsafe { aligned_cursor.add(size) };
-            return unsafe { NonNull::new_unchecked(aligned_cursor) };
+            return Ok(unsafe { NonNull::new_unchecked(aligned_cursor) });
         }
 
         // Doesn't fit - need new allocation strategy
         self.alloc_outlined(layout, available as usize)
     }
 
-    /// Get total bytes allocated by this arena
+    /// Grows the allocation of `old_size` bytes at `ptr` to `new_size` bytes without
+    /// moving it. This succeeds if it is the most recent allocation and the current block
+    /// has room.
+    #[inline]
+    pub fn try_extend_in_place(&mut self, ptr: *mut u8, old_size: usize, new_size: usize) -> bool {
+        if ptr.wrapping_add(old_size) != self.cursor {
+            return false;
+        }
+        if new_size > self.end as usize - ptr as usize {
+            return false;
+        }
+        self.cursor = unsafe { ptr.add(new_size) };
+        true
+    }
+
+    /// Get total bytes allocated by this arena, not counting the initial buffer
     pub fn bytes_allocated(&self) -> usize {
-        let mut total = 0;
-        let mut current = self.current;
+        self.stats().bytes_allocated
+    }
 
-        unsafe {
-            while !current.is_null() {
-                total += (*current).layout.size();
-                current = (*current).prev;
+    /// Counters of this arena, including its nested arenas
+    pub fn stats(&self) -> ArenaStats {
+        let mut stats = self.stats;
+        let mut nested = self.nested;
+        while !nested.is_null() {
+            unsafe {
+                let nested_stats = (*(*nested).arena.get()).stats();
+                stats.bytes_allocated += nested_stats.bytes_allocated;
+                stats.wasted_bytes += nested_stats.wasted_bytes;
+                stats.dedicated_allocations += nested_stats.dedicated_allocations;
+                nested = (*nested).next;
             }
         }
-
-        total
+        stats
     }
 
     /// Allocate a new memory block - never inlined to keep fast path small
     #[inline(never)]
-    fn alloc_outlined(&mut self, layout: Layout, available: usize) -> NonNull<u8> {
-        const SIGNIFICANT_SPACE_THRESHOLD: usize = 512; // 512 bytes is "significant"
-
-        if available >= SIGNIFICANT_SPACE_THRESHOLD {
+    fn alloc_outlined(
+        &mut self,
+        layout: Layout,
+        available: usize,
+    ) -> Result<NonNull<u8>, AllocError> {
+        if available >= self.policy.dedicated_threshold {
             // Significant free space left, which implies this is a large allocation
             // Keep the free space and just allocate a dedicated block for this allocation
             // and keep the current block for future allocations.
@@ -114,7 +678,17 @@ impl<'a> Arena<'a> {
     }
 
     /// Allocate a new memory block
-    fn allocate_new_block(&mut self, alloc_layout: Layout) -> NonNull<u8> {
+    fn allocate_new_block(&mut self, alloc_layout: Layout) -> Result<NonNull<u8>, AllocError> {
+        self.stats.wasted_bytes += (self.end as usize).saturating_sub(self.cursor as usize);
+        if let Some((block, data)) = self.take_free_block(alloc_layout, false) {
+            unsafe {
+                (*block).prev = self.current;
+                self.current = block;
+                self.cursor = data.add(alloc_layout.size());
+                self.end = (block as *mut u8).add((*block).layout.size());
+                return Ok(NonNull::new_unchecked(data));
+            }
+        }
         // Calculate block size - grow exponentially but respect min_size
 
         let (layout, offset) = Layout::new::<MemBlock>()
@@ -123,53 +697,137 @@ impl<'a> Arena<'a> {
         let layout = layout.pad_to_align();
 
         let new_block_size = if self.current.is_null() {
-            DEFAULT_BLOCK_SIZE
+            self.policy.initial_block_size
         } else {
             let current_block_size = unsafe { (*self.current).layout.size() };
-            (current_block_size * 2).min(MAX_BLOCK_SIZE)
+            current_block_size
+                .saturating_mul(self.policy.growth_factor)
+                .min(self.policy.max_block_size)
         };
+        // Near the memory limit, a smaller block still serves the allocation
+        let new_block_size = new_block_size.min(self.remaining().saturating_sub(layout.size()));
 
         let (layout, block_start) = layout
             .extend(Layout::array::<u8>(new_block_size).expect("Layout overflow"))
             .expect("Layout overflow");
-        let layout = layout.pad_to_align();
-
-        let ptr = self
-            .allocator
-            .allocate(layout)
-            .expect("Allocation failed")
-            .as_ptr() as *mut MemBlock;
+        let (ptr, layout) = self.allocate_block(layout.pad_to_align())?;
 
         unsafe {
             // Initialize the MemBlock header
             (*ptr).prev = self.current;
-            (*ptr).layout = layout;
 
             // Update arena state - this becomes the new active block
             self.current = ptr;
             self.cursor = (ptr as *mut u8).add(block_start);
             self.end = (ptr as *mut u8).add(layout.size());
-            NonNull::new_unchecked((ptr as *mut u8).add(offset))
+            Ok(NonNull::new_unchecked((ptr as *mut u8).add(offset)))
         }
     }
 
-    /// Allocate a dedicated (large) memory directly from allocator (dedicated block)
-    fn alloc_dedicated(&mut self, layout: Layout) -> NonNull<u8> {
-        // Use layout extend for proper alignment
-        let memblock_layout = Layout::new::<MemBlock>();
-        let (extended_layout, data_offset) =
-            memblock_layout.extend(layout).expect("Layout overflow");
-        let final_layout = extended_layout.pad_to_align();
+    /// Allocates a block from the allocator. The allocator may return more memory than
+    /// requested, the returned layout covers all of it.
+    fn allocate_block(&mut self, layout: Layout) -> Result<(*mut MemBlock, Layout), AllocError> {
+        self.try_charge(layout.size())?;
+        let memory = match self.allocator.allocate(layout) {
+            Ok(memory) => memory,
+            Err(err) => {
+                self.uncharge(layout.size());
+                return Err(err);
+            }
+        };
+        // Memory beyond the request is counted even past the limit, it is already held
+        self.charge(memory.len() - layout.size());
+        let layout = Layout::from_size_align(memory.len(), layout.align()).unwrap();
+        let ptr = memory.as_ptr() as *mut MemBlock;
+        unsafe { (*ptr).layout = layout };
+        Ok((ptr, layout))
+    }
 
-        let ptr = self
-            .allocator
-            .allocate(final_layout)
-            .expect("Allocation failed")
-            .as_ptr() as *mut MemBlock;
+    // Bytes that can still be allocated before reaching the memory limit
+    fn remaining(&self) -> usize {
+        match unsafe { self.budget.as_ref() } {
+            Some(budget) => budget.remaining(),
+            None => self.memory_limit.saturating_sub(self.stats.bytes_allocated),
+        }
+    }
+
+    // Counts `bytes` as held from the allocator, or fails if that exceeds the memory limit
+    fn try_charge(&mut self, bytes: usize) -> Result<(), AllocError> {
+        match unsafe { self.budget.as_ref() } {
+            Some(budget) => budget.try_charge(bytes)?,
+            None if bytes > self.remaining() => return Err(AllocError),
+            None => {}
+        }
+        self.stats.bytes_allocated += bytes;
+        Ok(())
+    }
 
+    // Counts `bytes` as held from the allocator, regardless of the memory limit
+    fn charge(&mut self, bytes: usize) {
+        if let Some(budget) = unsafe { self.budget.as_ref() } {
+            budget.used.fetch_add(bytes, Ordering::Relaxed);
+        }
+        self.stats.bytes_allocated += bytes;
+    }
+
+    fn uncharge(&mut self, bytes: usize) {
+        if let Some(budget) = unsafe { self.budget.as_ref() } {
+            budget.used.fetch_sub(bytes, Ordering::Relaxed);
+        }
+        self.stats.bytes_allocated -= bytes;
+    }
+
+    /// Takes a block retained by reset that fits the allocation, the largest one or the
+    /// smallest one that fits. Returns the block and the address of the allocation.
+    fn take_free_block(
+        &mut self,
+        alloc_layout: Layout,
+        smallest: bool,
+    ) -> Option<(*mut MemBlock, *mut u8)> {
+        let data_in = |block: *mut MemBlock| unsafe {
+            let start = (block as *mut u8).add(size_of::<MemBlock>());
+            let end = (block as *mut u8).add((*block).layout.size());
+            let data = start.add(start.align_offset(alloc_layout.align()));
+            ((end as usize).saturating_sub(data as usize) >= alloc_layout.size()).then_some(data)
+        };
         unsafe {
-            (*ptr).layout = final_layout;
+            // The list is sorted by size, so the blocks that fit come first
+            let mut found = None;
+            let mut link = &raw mut self.free;
+            while !(*link).is_null() {
+                let Some(data) = data_in(*link) else {
+                    break;
+                };
+                found = Some((link, data));
+                if !smallest {
+                    break;
+                }
+                link = &raw mut (**link).prev;
+            }
+            let (link, data) = found?;
+            let block = *link;
+            *link = (*block).prev;
+            self.retained -= (*block).layout.size();
+            Some((block, data))
+        }
+    }
 
+    /// Allocate a dedicated (large) memory directly from allocator (dedicated block)
+    fn alloc_dedicated(&mut self, layout: Layout) -> Result<NonNull<u8>, AllocError> {
+        self.stats.dedicated_allocations += 1;
+        // Use layout extend for proper alignment
+        let (ptr, data_ptr) = match self.take_free_block(layout, true) {
+            Some(reused) => reused,
+            None => {
+                let memblock_layout = Layout::new::<MemBlock>();
+                let (extended_layout, data_offset) =
+                    memblock_layout.extend(layout).expect("Layout overflow");
+                let (ptr, _) = self.allocate_block(extended_layout.pad_to_align())?;
+                (ptr, unsafe { (ptr as *mut u8).add(data_offset) })
+            }
+        };
+
+        unsafe {
             // Insert just after current head, keeping current as head
             if !self.current.is_null() {
                 // Insert between current and current.prev
@@ -182,31 +840,196 @@ impl<'a> Arena<'a> {
                 // Still no active bump allocation (cursor/end remain null)
             }
 
-            // Return aligned data pointer after header
-            let data_ptr = (ptr as *mut u8).add(data_offset);
-            NonNull::new_unchecked(data_ptr)
+            Ok(NonNull::new_unchecked(data_ptr))
         }
     }
 }
 
+// Inserts a block into a list sorted by size, largest first
+unsafe fn insert_sorted(list: &mut *mut MemBlock, block: *mut MemBlock) {
+    unsafe {
+        let mut link = list;
+        while !(*link).is_null() && (**link).layout.size() >= (*block).layout.size() {
+            link = &mut (**link).prev;
+        }
+        (*block).prev = *link;
+        *link = block;
+    }
+}
+
 impl<'a> Drop for Arena<'a> {
     fn drop(&mut self) {
         unsafe {
-            let mut current = self.current;
-            while !current.is_null() {
-                let prev = (*current).prev;
-                let layout = (*current).layout;
+            self.drop_nested();
+            // A nested arena hands its memory back to the budget it shares
+            let bytes = self.stats.bytes_allocated;
+            self.uncharge(bytes);
+
+            for list in [self.current, self.free] {
+                let mut current = list;
+                while !current.is_null() {
+                    let prev = (*current).prev;
+                    let layout = (*current).layout;
 
-                // Deallocate this block with correct size
-                let ptr = NonNull::new_unchecked(current as *mut u8);
-                self.allocator.deallocate(ptr, layout);
+                    // Deallocate this block with correct size
+                    let ptr = NonNull::new_unchecked(current as *mut u8);
+                    self.allocator.deallocate(ptr, layout);
 
-                current = prev;
+                    current = prev;
+                }
             }
         }
     }
 }
 
+/// Allocator that has no memory. An arena over an initial buffer with this allocator
+/// panics when the buffer is exhausted instead of allocating.
+pub struct NoHeap;
+
+unsafe impl Allocator for NoHeap {
+    fn allocate(&self, _layout: Layout) -> Result<NonNull<[u8]>, core::alloc::AllocError> {
+        Err(core::alloc::AllocError)
+    }
+
+    unsafe fn deallocate(&self, _ptr: NonNull<u8>, _layout: Layout) {
+        unreachable!("NoHeap never allocates")
+    }
+}
+
+#[cfg(all(feature = "std", target_os = "linux"))]
+mod sys {
+    use core::ffi::c_void;
+
+    unsafe extern "C" {
+        pub fn mmap(
+            addr: *mut c_void,
+            len: usize,
+            prot: i32,
+            flags: i32,
+            fd: i32,
+            offset: isize,
+        ) -> *mut c_void;
+        pub fn munmap(addr: *mut c_void, len: usize) -> i32;
+        pub fn madvise(addr: *mut c_void, len: usize, advice: i32) -> i32;
+        fn sysconf(name: i32) -> i64;
+    }
+
+    pub const PROT_READ: i32 = 1;
+    pub const PROT_WRITE: i32 = 2;
+    pub const MAP_PRIVATE: i32 = 2;
+    pub const MAP_ANONYMOUS: i32 = 0x20;
+    pub const MADV_DONTNEED: i32 = 4;
+    pub const MADV_HUGEPAGE: i32 = 14;
+
+    pub fn page_size() -> usize {
+        const SC_PAGESIZE: i32 = 30;
+        unsafe { sysconf(SC_PAGESIZE) as usize }
+    }
+}
+
+// Hands the pages in [start, end) back to the OS. The memory stays allocated and reads
+// as zeros when touched again.
+#[cfg(all(feature = "std", target_os = "linux"))]
+fn release_pages(start: *mut u8, end: *mut u8) {
+    let page_size = sys::page_size();
+    let start = (start as usize).next_multiple_of(page_size);
+    let end = end as usize & !(page_size - 1);
+    if start < end {
+        unsafe { sys::madvise(start as *mut _, end - start, sys::MADV_DONTNEED) };
+    }
+}
+
+#[cfg(not(all(feature = "std", target_os = "linux")))]
+fn release_pages(_start: *mut u8, _end: *mut u8) {}
+
+/// Allocator for arenas with large blocks. Allocations of at least `min_size` bytes are
+/// mapped directly with mmap, aligned to and rounded up to whole 2MB huge pages, and
+/// marked for transparent huge pages to reduce TLB pressure. Smaller allocations are
+/// passed to `fallback`. Use it with a `GrowthPolicy` whose blocks reach `min_size`.
+#[cfg(all(feature = "std", target_os = "linux"))]
+pub struct MmapAllocator<A: Allocator = std::alloc::Global> {
+    pub min_size: usize,
+    pub fallback: A,
+}
+
+#[cfg(all(feature = "std", target_os = "linux"))]
+impl MmapAllocator {
+    pub const HUGE_PAGE_SIZE: usize = 2 * 1024 * 1024;
+
+    pub const fn new() -> Self {
+        MmapAllocator {
+            min_size: Self::HUGE_PAGE_SIZE,
+            fallback: std::alloc::Global,
+        }
+    }
+}
+
+#[cfg(all(feature = "std", target_os = "linux"))]
+impl Default for MmapAllocator {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+#[cfg(all(feature = "std", target_os = "linux"))]
+impl<A: Allocator> MmapAllocator<A> {
+    fn is_mapped(&self, layout: Layout) -> bool {
+        layout.size() >= self.min_size && layout.align() <= MmapAllocator::HUGE_PAGE_SIZE
+    }
+}
+
+#[cfg(all(feature = "std", target_os = "linux"))]
+unsafe impl<A: Allocator> Allocator for MmapAllocator<A> {
+    fn allocate(&self, layout: Layout) -> Result<NonNull<[u8]>, core::alloc::AllocError> {
+        if !self.is_mapped(layout) {
+            return self.fallback.allocate(layout);
+        }
+        const HUGE: usize = MmapAllocator::HUGE_PAGE_SIZE;
+        let len = layout.size().next_multiple_of(HUGE);
+        // Map an extra huge page, so that an aligned range can be cut out of it
+        let map_len = len + HUGE;
+        let ptr = unsafe {
+            sys::mmap(
+                ptr::null_mut(),
+                map_len,
+                sys::PROT_READ | sys::PROT_WRITE,
+                sys::MAP_PRIVATE | sys::MAP_ANONYMOUS,
+                -1,
+                0,
+            )
+        };
+        if ptr as isize == -1 {
+            return Err(core::alloc::AllocError);
+        }
+        let start = ptr as usize;
+        let aligned = start.next_multiple_of(HUGE);
+        unsafe {
+            if aligned > start {
+                sys::munmap(ptr, aligned - start);
+            }
+            let tail = start + map_len - (aligned + len);
+            if tail > 0 {
+                sys::munmap((aligned + len) as *mut _, tail);
+            }
+            sys::madvise(aligned as *mut _, len, sys::MADV_HUGEPAGE);
+            Ok(NonNull::slice_from_raw_parts(
+                NonNull::new_unchecked(aligned as *mut u8),
+                len,
+            ))
+        }
+    }
+
+    unsafe fn deallocate(&self, ptr: NonNull<u8>, layout: Layout) {
+        if !self.is_mapped(layout) {
+            return unsafe { self.fallback.deallocate(ptr, layout) };
+        }
+        let len = layout
+            .size()
+            .next_multiple_of(MmapAllocator::HUGE_PAGE_SIZE);
+        unsafe { sys::munmap(ptr.as_ptr() as *mut _, len) };
+    }
+}
+
 // Safety: Arena can be sent between threads if the allocator supports it
 unsafe impl<'a> Send for Arena<'a> where &'a dyn Allocator: Send {}
 
@@ -276,4 +1099,350 @@ mod tests {
             assert_eq!(large_slice[large_slice.len() - 1], 2);
         }
     }
+
+    struct CountingAllocator(core::cell::Cell<usize>);
+
+    unsafe impl Allocator for CountingAllocator {
+        fn allocate(&self, layout: Layout) -> Result<NonNull<[u8]>, core::alloc::AllocError> {
+            self.0.set(self.0.get() + 1);
+            Global.allocate(layout)
+        }
+
+        unsafe fn deallocate(&self, ptr: NonNull<u8>, layout: Layout) {
+            unsafe { Global.deallocate(ptr, layout) }
+        }
+    }
+
+    #[test]
+    fn test_reset_reuses_blocks() {
+        let allocator = CountingAllocator(core::cell::Cell::new(0));
+        let mut arena = Arena::new(&allocator);
+        let fill = |arena: &mut Arena| {
+            for i in 0..1000 {
+                let slice = unsafe { &mut *arena.alloc_slice::<u64>(i % 50 + 1) };
+                slice.fill(i as u64);
+            }
+            let large = unsafe { &mut *arena.alloc_slice::<u8>(DEFAULT_BLOCK_SIZE * 3) };
+            large.fill(1);
+        };
+        fill(&mut arena);
+        assert!(allocator.0.get() > 1);
+        // The first reset keeps the largest block, which may need one more block to grow
+        arena.reset();
+        fill(&mut arena);
+        arena.reset();
+        let allocated = arena.bytes_allocated();
+        let calls = allocator.0.get();
+        for _ in 0..10 {
+            fill(&mut arena);
+            arena.reset();
+        }
+        assert_eq!(allocator.0.get(), calls);
+        assert_eq!(arena.bytes_allocated(), allocated);
+
+        arena.set_retention(0, 0);
+        arena.reset();
+        assert_eq!(arena.bytes_allocated(), 0);
+    }
+
+    #[test]
+    fn test_reset_releases_pages() {
+        let mut arena = Arena::new(&Global);
+        arena.set_retention(usize::MAX, DEFAULT_BLOCK_SIZE);
+        let slice = unsafe { &mut *arena.alloc_slice::<u8>(MAX_BLOCK_SIZE) };
+        slice.fill(0xff);
+        arena.reset();
+        let allocated = arena.bytes_allocated();
+        let slice = unsafe { &mut *arena.alloc_slice::<u8>(MAX_BLOCK_SIZE) };
+        assert_eq!(arena.bytes_allocated(), allocated);
+        // Released pages read as zeros, the resident ones keep their contents
+        #[cfg(target_os = "linux")]
+        {
+            assert_eq!(slice[0], 0xff);
+            assert_eq!(slice[MAX_BLOCK_SIZE - 1], 0);
+        }
+        slice.fill(0);
+    }
+
+    #[test]
+    fn test_initial_buffer() {
+        let mut buffer = [MaybeUninit::<u8>::uninit(); 1024];
+        let range = buffer.as_ptr_range();
+        let range = range.start as usize..range.end as usize;
+        {
+            let mut arena = Arena::with_initial_buffer(&mut buffer, &NoHeap);
+            for i in 0..100u64 {
+                let ptr = arena.place(i);
+                assert!(range.contains(&(ptr as *mut u64 as usize)));
+            }
+            arena.reset();
+            let ptr: *mut [u64] = arena.alloc_slice(100);
+            assert!(range.contains(&(ptr as *mut u64 as usize)));
+            assert_eq!(arena.bytes_allocated(), 0);
+        }
+
+        // Falls back to the allocator once the buffer is full
+        let mut arena = Arena::with_initial_buffer(&mut buffer, &Global);
+        let slice = unsafe { &mut *arena.alloc_slice::<u64>(1000) };
+        slice.fill(1);
+        assert!(!range.contains(&(slice.as_ptr() as usize)));
+        assert!(arena.bytes_allocated() > 0);
+    }
+
+    #[test]
+    fn test_growth_policy() {
+        let policy = GrowthPolicy {
+            initial_block_size: 1024,
+            growth_factor: 4,
+            max_block_size: 16 * 1024,
+            dedicated_threshold: 1024,
+        };
+        let mut arena = Arena::with_policy(&Global, policy);
+        let mut blocks = Vec::new();
+        for _ in 0..200 {
+            let allocated = arena.bytes_allocated();
+            arena.alloc_slice::<u8>(1000);
+            if arena.bytes_allocated() != allocated {
+                blocks.push(arena.bytes_allocated() - allocated);
+            }
+        }
+        // Each block also holds the allocation that triggered it
+        assert!(blocks[0] < 4096);
+        assert!(blocks[1] >= 4 * blocks[0]);
+        assert!(blocks.iter().all(|&size| size <= 16 * 1024 + 1024));
+        assert!(blocks.len() > 8);
+        assert!(arena.stats().wasted_bytes > 0);
+        assert_eq!(arena.stats().dedicated_allocations, 0);
+
+        let policy = GrowthPolicy {
+            dedicated_threshold: 64,
+            ..policy
+        };
+        let mut arena = Arena::with_policy(&Global, policy);
+        arena.alloc_slice::<u8>(100);
+        // Most of the first block is left, so this gets a block of its own
+        arena.alloc_slice::<u8>(2000);
+        arena.alloc_slice::<u8>(100);
+        assert_eq!(arena.stats().dedicated_allocations, 1);
+        assert_eq!(arena.stats().wasted_bytes, 0);
+    }
+
+    #[cfg(target_os = "linux")]
+    #[test]
+    fn test_mmap_allocator() {
+        let allocator = MmapAllocator::new();
+        let policy = GrowthPolicy {
+            initial_block_size: MmapAllocator::HUGE_PAGE_SIZE,
+            max_block_size: 8 * MmapAllocator::HUGE_PAGE_SIZE,
+            ..GrowthPolicy::DEFAULT
+        };
+        let mut arena = Arena::with_policy(&allocator, policy);
+        for i in 0..10 {
+            let slice = unsafe { &mut *arena.alloc_slice::<u64>(256 * 1024) };
+            slice.fill(i);
+            assert_eq!(slice.as_ptr() as usize % 8, 0);
+        }
+        assert_eq!(arena.bytes_allocated() % MmapAllocator::HUGE_PAGE_SIZE, 0);
+        // Small allocations go to the fallback allocator
+        let mut small = Arena::new(&allocator);
+        small.alloc_slice::<u8>(100);
+        assert!(small.bytes_allocated() < MmapAllocator::HUGE_PAGE_SIZE);
+    }
+
+    #[test]
+    fn test_extend_in_place() {
+        let mut arena = Arena::new(&Global);
+        let ptr = arena.alloc_slice::<u32>(10) as *mut u8;
+        assert!(arena.try_extend_in_place(ptr, 40, 80));
+        let next = arena.alloc::<u32>() as *mut u8;
+        assert_eq!(next, ptr.wrapping_add(80));
+        // No longer the last allocation
+        assert!(!arena.try_extend_in_place(ptr, 80, 160));
+        assert!(!arena.try_extend_in_place(next, 4, DEFAULT_BLOCK_SIZE * 2));
+        assert!(arena.try_extend_in_place(next, 4, 8));
+
+        // A growing repeated field stays in place instead of leaving copies behind
+        let mut arena = Arena::new(&Global);
+        let mut field = crate::containers::RepeatedField::<u32>::new();
+        for i in 0..1500 {
+            field.push(i, &mut arena);
+        }
+        assert!(arena.bytes_allocated() < 2 * DEFAULT_BLOCK_SIZE);
+        assert!(field.iter().copied().eq(0..1500));
+    }
+
+    #[test]
+    fn test_rollback() {
+        let allocator = CountingAllocator(core::cell::Cell::new(0));
+        let mut arena = Arena::new(&allocator);
+        let speculate = |arena: &mut Arena| {
+            for i in 0..1000 {
+                let slice = unsafe { &mut *arena.alloc_slice::<u64>(i % 50 + 1) };
+                slice.fill(i as u64);
+            }
+            // Dedicated blocks behind the current block
+            for _ in 0..3 {
+                let large = unsafe { &mut *arena.alloc_slice::<u8>(DEFAULT_BLOCK_SIZE * 2) };
+                large.fill(1);
+            }
+            let nested = arena.alloc::<NestedArena>();
+            unsafe { arena.init_nested(nested, 64).unwrap() };
+        };
+
+        // Rolling back to an empty arena
+        let empty = arena.checkpoint();
+        speculate(&mut arena);
+        unsafe { arena.rollback(empty) };
+        assert!(arena.current.is_null() && arena.nested.is_null());
+
+        let kept = arena.place(42u64);
+        // A dedicated block from before the checkpoint must survive the rollback
+        let kept_large = unsafe { &mut *arena.alloc_slice::<u8>(MAX_BLOCK_SIZE) };
+        kept_large.fill(7);
+        let checkpoint = arena.checkpoint();
+        let next = arena.alloc::<u64>();
+        speculate(&mut arena);
+        unsafe { arena.rollback(checkpoint) };
+        assert_eq!(arena.alloc::<u64>(), next);
+        assert_eq!(*kept, 42);
+        assert!(kept_large.iter().all(|&b| b == 7));
+
+        // The released blocks are reused by the retry
+        unsafe { arena.rollback(checkpoint) };
+        let calls = allocator.0.get();
+        speculate(&mut arena);
+        assert_eq!(allocator.0.get(), calls);
+        unsafe { arena.rollback(checkpoint) };
+        assert_eq!(arena.alloc::<u64>(), next);
+
+        // The running count of retained bytes matches the free list
+        let mut retained = 0;
+        let mut block = arena.free;
+        while !block.is_null() {
+            unsafe {
+                retained += (*block).layout.size();
+                block = (*block).prev;
+            }
+        }
+        assert_eq!(arena.retained, retained);
+    }
+
+    #[test]
+    fn test_fuse() {
+        let mut arena = Arena::new(&Global);
+        let mut parts = Vec::new();
+        for i in 0..4u64 {
+            let mut other = Arena::new(&Global);
+            let slice = unsafe { &mut *other.alloc_slice::<u64>(1000) };
+            slice.fill(i);
+            parts.push(&*slice);
+            arena.fuse(other);
+        }
+        // The memory of the fused arenas is owned by the arena, and is not copied
+        assert!(arena.bytes_allocated() >= 4 * 8000);
+        for (i, part) in parts.iter().enumerate() {
+            assert!(part.iter().all(|&x| x == i as u64));
+        }
+        let stats = arena.stats();
+        arena.fuse(Arena::new(&Global));
+        assert_eq!(arena.stats().bytes_allocated, stats.bytes_allocated);
+
+        // The fused arena may use another allocator, which frees its blocks
+        let mut other = Arena::new(&std::alloc::System);
+        let value = other.place(7u64);
+        arena.fuse(other);
+        assert_eq!(*value, 7);
+        assert!(arena.stats().bytes_allocated > stats.bytes_allocated);
+    }
+
+    #[test]
+    fn test_memory_limit() {
+        let mut arena = Arena::new(&Global);
+        arena.set_memory_limit(3 * DEFAULT_BLOCK_SIZE);
+        for _ in 0..DEFAULT_BLOCK_SIZE / 64 {
+            assert!(arena.try_alloc_raw(Layout::new::<[u64; 8]>()).is_ok());
+        }
+        assert!(
+            arena
+                .try_alloc_raw(Layout::array::<u8>(3 * DEFAULT_BLOCK_SIZE).unwrap())
+                .is_err()
+        );
+        // The next block would exceed the limit at full size, but still fits smaller
+        for _ in 0..DEFAULT_BLOCK_SIZE / 64 {
+            assert!(arena.try_alloc_raw(Layout::new::<[u64; 8]>()).is_ok());
+        }
+        assert!(arena.bytes_allocated() <= 3 * DEFAULT_BLOCK_SIZE);
+
+        let mut field = crate::containers::RepeatedField::<u64>::new();
+        while field.try_push(1, &mut arena).is_ok() {}
+        assert!(arena.bytes_allocated() <= 3 * DEFAULT_BLOCK_SIZE);
+
+        // At the limit, fuse hands the other arena back
+        while arena.try_alloc_raw(Layout::new::<u64>()).is_ok() {}
+        let mut other = Arena::new(&Global);
+        let value = other.place(7u64);
+        let other = arena.try_fuse(other).unwrap_err();
+        assert_eq!(*value, 7);
+        drop(other);
+    }
+
+    #[test]
+    fn test_nested_memory_limit() {
+        let mut arena = Arena::new(&Global);
+        arena.set_memory_limit(8 * DEFAULT_BLOCK_SIZE);
+        let layout = Layout::array::<u8>(2 * DEFAULT_BLOCK_SIZE).unwrap();
+        let mut nested = [ptr::null_mut(); 2];
+        for nested in &mut nested {
+            *nested = arena.alloc::<NestedArena>() as *mut NestedArena;
+            unsafe { arena.init_nested(*nested, 0).unwrap() };
+        }
+        let [first, second] = nested.map(|nested| unsafe { (*nested).get() });
+
+        // Nested arenas allocate from one budget, shared with the parent
+        assert!(first.try_alloc_raw(layout).is_ok());
+        assert!(second.try_alloc_raw(layout).is_ok());
+        assert!(first.try_alloc_raw(layout).is_err());
+        assert!(arena.try_alloc_raw(layout).is_err());
+        assert!(arena.bytes_allocated() <= 8 * DEFAULT_BLOCK_SIZE);
+
+        // Raising the limit raises it for the nested arenas too
+        arena.set_memory_limit(16 * DEFAULT_BLOCK_SIZE);
+        assert!(first.try_alloc_raw(layout).is_ok());
+
+        // Rolling back a nested arena returns its memory to the budget
+        let checkpoint = arena.checkpoint();
+        let nested = arena.alloc::<NestedArena>() as *mut NestedArena;
+        unsafe { arena.init_nested(nested, 0).unwrap() };
+        let third = unsafe { (*nested).get() };
+        while third.try_alloc_raw(layout).is_ok() {}
+        assert!(arena.try_alloc_raw(layout).is_err());
+        unsafe { arena.rollback(checkpoint) };
+        assert!(arena.try_alloc_raw(layout).is_ok());
+        assert!(arena.bytes_allocated() <= 16 * DEFAULT_BLOCK_SIZE);
+    }
+
+    #[test]
+    fn test_recycle() {
+        let mut arena = Arena::new(&Global);
+        assert_eq!(arena.take_recycled(8), None);
+        let a = arena.alloc::<u64>() as *mut u8;
+        let b = arena.alloc::<u64>() as *mut u8;
+        unsafe {
+            arena.recycle(8, a);
+            arena.recycle(16, b);
+        }
+        assert!(arena.is_recycling());
+        assert_eq!(arena.take_recycled(16), Some(b));
+        assert_eq!(arena.take_recycled(16), None);
+        assert_eq!(arena.take_recycled(8), Some(a));
+
+        // Recycled memory does not survive a rollback or reset
+        let checkpoint = arena.checkpoint();
+        unsafe { arena.recycle(8, a) };
+        unsafe { arena.rollback(checkpoint) };
+        assert_eq!(arena.take_recycled(8), None);
+        unsafe { arena.recycle(8, a) };
+        arena.reset();
+        assert!(!arena.is_recycling());
+    }
 }
@@ -1,10 +1,34 @@
-use core::alloc::Layout;
+use core::alloc::{AllocError, Layout};
+use core::sync::atomic::{AtomicPtr, AtomicU8, Ordering};
 
 use crate::{
-    arena::Arena,
-    containers::{Bytes, RepeatedField},
+    arena::{Arena, NestedArena},
+    containers::{Bytes, RawRepeatedField, RepeatedField},
+    encoding::TableEntry,
+    tables::{AuxTableEntry, Table},
+    wire::FieldKind,
 };
 
+// Keys of memory recycled by `reuse_clear` in the arena. Message objects are keyed by the
+// address of their table, which never collides with these small values. Byte buffers
+// are binned by capacity, a buffer in class n holds at least 2^n bytes.
+const RECYCLED_LAZY: usize = 1;
+const MIN_BUFFER_CLASS: u32 = 3;
+
+const fn buffer_key(class: u32) -> usize {
+    ((class as usize) << 2) | 2
+}
+
+fn object_key(table: &Table) -> usize {
+    table as *const Table as usize
+}
+
+// Object memory whose contents were copied into an inline element, kept for the next
+// cleared element. Tables are aligned, so the low bit sets it apart from object keys.
+fn spare_key(table: &Table) -> usize {
+    object_key(table) | 1
+}
+
 #[derive(Debug, Default, Clone, Copy)]
 #[repr(C)]
 pub struct Message(pub *mut Object);
@@ -18,19 +42,351 @@ impl Message {
     }
 }
 
+/// Field storage of a singular submessage marked `[lazy = true]`. Null if the field is
+/// not set.
+#[derive(Debug, Default, Clone, Copy)]
+#[repr(C)]
+pub struct LazyMessage(pub *mut LazyObject);
+
+unsafe impl Send for LazyMessage {}
+unsafe impl Sync for LazyMessage {}
+
+impl LazyMessage {
+    /// The decoded submessage, or None if the field is not set or its bytes fail to
+    /// decode.
+    pub fn get(&self, table: &Table) -> Option<&Object> {
+        if self.0.is_null() {
+            None
+        } else {
+            unsafe { (*self.0).try_get(table) }
+        }
+    }
+
+    pub fn get_or_create(&mut self, table: &Table, arena: &mut Arena) -> &mut Object {
+        if self.0.is_null() {
+            self.0 = LazyObject::create(table.size as usize, arena);
+        }
+        unsafe { (*self.0).get_mut(table) }
+    }
+}
+
+pub(crate) enum LazyContents<'a> {
+    Encoded(&'a [u8]),
+    Object(&'a Object),
+}
+
+const ENCODED: u8 = 0;
+const DECODING: u8 = 1;
+const DECODED: u8 = 2;
+const MODIFIED: u8 = 3;
+const INVALID: u8 = 4;
+
+/// A submessage that is kept in encoded form until it is first accessed. The decoded
+/// object lives in a nested arena, so it can be created behind a shared reference. The
+/// nested arena starts out in a slice of the parent arena sized for the submessage, so
+/// small lazy fields do not cost a block each.
+/// Until the object is handed out mutably, the encoded bytes stay authoritative and are
+/// written out as is when the parent is encoded.
+pub struct LazyObject {
+    bytes: Bytes,
+    state: AtomicU8,
+    object: AtomicPtr<Object>,
+    arena: NestedArena,
+}
+
+impl LazyObject {
+    pub(crate) fn create(initial_size: usize, arena: &mut Arena) -> *mut LazyObject {
+        Self::try_create(initial_size, arena).expect("Allocation failed")
+    }
+
+    /// Creates an empty lazy object whose nested arena can hold `initial_size` bytes
+    /// before it allocates blocks.
+    pub(crate) fn try_create(
+        initial_size: usize,
+        arena: &mut Arena,
+    ) -> Result<*mut LazyObject, AllocError> {
+        if let Some(lazy) = arena.take_recycled(RECYCLED_LAZY) {
+            return Ok(lazy as *mut LazyObject);
+        }
+        let lazy = arena.try_alloc_raw(Layout::new::<LazyObject>())?.as_ptr() as *mut LazyObject;
+        unsafe {
+            (&raw mut (*lazy).bytes).write(Bytes::new());
+            (&raw mut (*lazy).state).write(AtomicU8::new(ENCODED));
+            (&raw mut (*lazy).object).write(AtomicPtr::new(core::ptr::null_mut()));
+            arena.init_nested(&raw mut (*lazy).arena, initial_size)?;
+        }
+        Ok(lazy)
+    }
+
+    // Empties the lazy object for reuse, keeping the capacity of the encoded bytes and the
+    // blocks of the nested arena.
+    fn reuse_clear(&mut self) {
+        self.bytes.clear();
+        *self.state.get_mut() = ENCODED;
+        *self.object.get_mut() = core::ptr::null_mut();
+        unsafe { self.arena.get().reset() };
+    }
+
+    /// Stores an already decoded object, which has no encoded form.
+    #[cfg(feature = "serde_support")]
+    pub(crate) fn set(&mut self, object: *mut Object) {
+        *self.object.get_mut() = object;
+        *self.state.get_mut() = MODIFIED;
+    }
+
+    /// What to encode: the original bytes, unless the object was handed out mutably.
+    pub(crate) fn contents(&self) -> LazyContents<'_> {
+        if self.state.load(Ordering::Acquire) == MODIFIED {
+            LazyContents::Object(unsafe { &*self.object.load(Ordering::Relaxed) })
+        } else {
+            LazyContents::Encoded(self.bytes.as_ref())
+        }
+    }
+
+    /// Storage for the encoded submessage, only valid while nothing is decoded.
+    pub(crate) fn bytes_mut(&mut self) -> Option<&mut Bytes> {
+        if *self.state.get_mut() == ENCODED {
+            Some(&mut self.bytes)
+        } else {
+            None
+        }
+    }
+
+    /// Decodes the submessage on first access. Concurrent first accesses wait for the one
+    /// that decodes. Returns None if the bytes fail to decode, or need more memory than the
+    /// arena had left when the lazy object was created. Nothing they decoded to is kept.
+    pub fn try_get(&self, table: &Table) -> Option<&Object> {
+        let mut spins = 0;
+        loop {
+            match self.state.compare_exchange(
+                ENCODED,
+                DECODING,
+                Ordering::Acquire,
+                Ordering::Acquire,
+            ) {
+                Ok(_) => {
+                    // SAFETY: The DECODING state gives exclusive access to the nested arena.
+                    let arena = unsafe { self.arena.get() };
+                    if let Ok(object) = Object::try_create(table.size as u32, arena)
+                        && crate::decoding::decode_lazy(object, table, self.bytes.as_ref(), arena)
+                    {
+                        self.object.store(object, Ordering::Relaxed);
+                        self.state.store(DECODED, Ordering::Release);
+                    } else {
+                        // Nothing references the partially decoded object
+                        arena.reset();
+                        self.state.store(INVALID, Ordering::Release);
+                    }
+                }
+                Err(DECODING) => backoff(&mut spins),
+                Err(INVALID) => return None,
+                Err(_) => return Some(unsafe { &*self.object.load(Ordering::Relaxed) }),
+            }
+        }
+    }
+
+    /// Decodes the submessage if needed and marks the encoded bytes as stale. Returns None
+    /// if the bytes fail to decode.
+    pub(crate) fn try_get_mut(&mut self, table: &Table) -> Option<&mut Object> {
+        self.try_get(table)?;
+        *self.state.get_mut() = MODIFIED;
+        Some(unsafe { &mut **self.object.get_mut() })
+    }
+
+    /// Like `try_get_mut`, but bytes that fail to decode are dropped and replaced by an
+    /// empty submessage.
+    pub fn get_mut(&mut self, table: &Table) -> &mut Object {
+        if self.try_get(table).is_none() {
+            // SAFETY: Nothing was decoded into the nested arena
+            let arena = unsafe { self.arena.get() };
+            *self.object.get_mut() = Object::create(table.size as u32, arena);
+        }
+        *self.state.get_mut() = MODIFIED;
+        unsafe { &mut **self.object.get_mut() }
+    }
+}
+
+// Waits for another thread to make progress. Spins for a short while, then gives up the
+// CPU where the platform allows it.
+fn backoff(spins: &mut u32) {
+    const SPIN_LIMIT: u32 = 64;
+    if *spins < SPIN_LIMIT {
+        *spins += 1;
+        core::hint::spin_loop();
+    } else {
+        #[cfg(feature = "std")]
+        std::thread::yield_now();
+        #[cfg(not(feature = "std"))]
+        core::hint::spin_loop();
+    }
+}
+
 pub struct Object;
 
 impl Object {
     pub fn create(size: u32, arena: &mut Arena) -> &'static mut Object {
+        Self::try_create(size, arena).expect("Allocation failed")
+    }
+
+    pub fn try_create(size: u32, arena: &mut Arena) -> Result<&'static mut Object, AllocError> {
         unsafe {
             let buffer = arena
-                .alloc_raw(Layout::from_size_align_unchecked(
+                .try_alloc_raw(Layout::from_size_align_unchecked(
                     size as usize,
                     core::mem::align_of::<u64>(),
-                ))
+                ))?
                 .as_ptr();
             core::ptr::write_bytes(buffer, 0, size as usize);
-            &mut *(buffer as *mut Object)
+            Ok(&mut *(buffer as *mut Object))
+        }
+    }
+
+    /// Like `try_create`, but reuses an object of this table recycled by `reuse_clear`
+    /// when the arena has one.
+    #[inline]
+    pub fn try_create_for(
+        table: &Table,
+        arena: &mut Arena,
+    ) -> Result<&'static mut Object, AllocError> {
+        match arena.take_recycled(object_key(table)) {
+            Some(object) => Ok(unsafe { &mut *(object as *mut Object) }),
+            None => Self::try_create(table.size as u32, arena),
+        }
+    }
+
+    /// Clears the object for decoding into it again, without giving up the memory it
+    /// references. Only scalars whose has bit is set are zeroed. Bytes and repeated
+    /// fields keep their capacity. Submessages, copies of inline repeated elements, lazy
+    /// submessages and the buffers of repeated bytes are cleared in turn and recycled in
+    /// `arena`, where the decoder picks them up instead of allocating.
+    ///
+    /// # Safety
+    /// Everything the object references must be owned by `arena`, or by an arena that
+    /// outlives it, and not be shared with other objects.
+    pub(crate) unsafe fn reuse_clear(&mut self, table: &Table, arena: &mut Arena) {
+        for &TableEntry {
+            has_bit,
+            kind,
+            offset,
+            ..
+        } in table.encode_entries()
+        {
+            let offset = offset as u32;
+            match kind {
+                FieldKind::Unknown => {}
+                FieldKind::Varint64 | FieldKind::Varint64Zigzag | FieldKind::Fixed64 => {
+                    self.clear_scalar::<u64>(offset, has_bit)
+                }
+                FieldKind::Varint32
+                | FieldKind::Int32
+                | FieldKind::Varint32Zigzag
+                | FieldKind::Fixed32 => self.clear_scalar::<u32>(offset, has_bit),
+                FieldKind::Bool => self.clear_scalar::<bool>(offset, has_bit),
+                FieldKind::BoolBit => {
+                    self.clear_has_bit(has_bit as u32);
+                    self.set_bit(offset, false);
+                }
+                FieldKind::Bytes | FieldKind::String => {
+                    self.clear_has_bit(has_bit as u32);
+                    self.ref_mut::<Bytes>(offset).clear();
+                }
+                FieldKind::Message | FieldKind::Group => {
+                    let AuxTableEntry {
+                        offset,
+                        child_table,
+                    } = table.aux_entry(offset as usize);
+                    let field = self.ref_mut::<*mut Object>(offset);
+                    if !field.is_null() {
+                        unsafe { recycle_object(*field, &*child_table, arena) };
+                        *field = core::ptr::null_mut();
+                    }
+                }
+                FieldKind::InlineMessage => {
+                    // The child is kept empty while its has bit is clear
+                    if self.has_bit(has_bit) {
+                        self.clear_has_bit(has_bit as u32);
+                        let AuxTableEntry {
+                            offset,
+                            child_table,
+                        } = table.aux_entry(offset as usize);
+                        unsafe {
+                            self.ref_mut::<Object>(offset)
+                                .reuse_clear(&*child_table, arena)
+                        };
+                    }
+                }
+                FieldKind::LazyMessage => {
+                    let offset = table.aux_entry(offset as usize).offset;
+                    let field = self.ref_mut::<LazyMessage>(offset);
+                    if !field.0.is_null() {
+                        unsafe {
+                            (*field.0).reuse_clear();
+                            arena.recycle(RECYCLED_LAZY, field.0 as *mut u8);
+                        }
+                        field.0 = core::ptr::null_mut();
+                    }
+                }
+                FieldKind::RepeatedBytes | FieldKind::RepeatedString => {
+                    let field = self.ref_mut::<RepeatedField<Bytes>>(offset);
+                    // Recycled last to first, so the first element gets its buffer back
+                    for bytes in field.iter().rev() {
+                        let cap = bytes.capacity();
+                        let class = usize::BITS - 1 - cap.max(1).leading_zeros();
+                        if class >= MIN_BUFFER_CLASS {
+                            unsafe { arena.recycle(buffer_key(class), bytes.as_ptr() as *mut u8) };
+                        }
+                    }
+                    field.clear();
+                }
+                FieldKind::RepeatedMessage | FieldKind::RepeatedGroup => {
+                    let AuxTableEntry {
+                        offset,
+                        child_table,
+                    } = table.aux_entry(offset as usize);
+                    let field = self.ref_mut::<RepeatedField<*mut Object>>(offset);
+                    for &child in field.iter().rev() {
+                        unsafe { recycle_object(child, &*child_table, arena) };
+                    }
+                    field.clear();
+                }
+                FieldKind::RepeatedInlineMessage => {
+                    let AuxTableEntry {
+                        offset,
+                        child_table,
+                    } = table.aux_entry(offset as usize);
+                    let child_table = unsafe { &*child_table };
+                    // Adding an element overwrites it, so the cleared elements are recycled
+                    // as copies, which take the place of the objects of a pointer field
+                    let field = self.ref_mut::<RawRepeatedField>(offset);
+                    for i in (0..field.len()).rev() {
+                        unsafe {
+                            let child = field.as_ptr().add(i * child_table.size as usize);
+                            let child = child as *mut Object;
+                            (*child).reuse_clear(child_table, arena);
+                            recycle_copy(child, child_table, arena);
+                        }
+                    }
+                    field.clear();
+                }
+                FieldKind::RepeatedVarint64
+                | FieldKind::RepeatedVarint32
+                | FieldKind::RepeatedInt32
+                | FieldKind::RepeatedVarint64Zigzag
+                | FieldKind::RepeatedVarint32Zigzag
+                | FieldKind::RepeatedBool
+                | FieldKind::RepeatedFixed64
+                | FieldKind::RepeatedFixed32 => {
+                    // The elements need no drop, only the length is reset
+                    self.ref_mut::<RepeatedField<u8>>(offset).clear();
+                }
+            }
+        }
+    }
+
+    fn clear_scalar<T: Default>(&mut self, offset: u32, has_bit: u8) {
+        if self.has_bit(has_bit) {
+            self.clear_has_bit(has_bit as u32);
+            *self.ref_mut::<T>(offset) = T::default();
         }
     }
 
@@ -54,6 +410,18 @@ impl Object {
         *self.ref_mut::<u32>(has_bit_word * 4) |= 1 << has_bit_idx;
     }
 
+    /// Reads a bit of the has bits array, which also holds the values of bools stored as
+    /// bits.
+    pub const fn bit(&self, idx: u32) -> bool {
+        let word = *self.ref_at::<u32>((idx / 32) as usize * core::mem::size_of::<u32>());
+        word & (1 << (idx % 32)) != 0
+    }
+
+    pub fn set_bit(&mut self, idx: u32, value: bool) {
+        let word = self.ref_mut::<u32>(idx / 32 * 4);
+        *word = (*word & !(1 << (idx % 32))) | ((value as u32) << (idx % 32));
+    }
+
     pub fn clear_has_bit(&mut self, has_bit_idx: u32) {
         let has_bit_word = has_bit_idx / 32;
         let has_bit_idx = has_bit_idx % 32;
@@ -75,9 +443,38 @@ impl Object {
         field
     }
 
-    pub(crate) fn add<T>(&mut self, offset: u32, val: T, arena: &mut Arena) {
+    pub(crate) fn add<T>(
+        &mut self,
+        offset: u32,
+        val: T,
+        arena: &mut Arena,
+    ) -> Result<(), AllocError> {
         let field = self.ref_mut::<RepeatedField<T>>(offset);
-        field.push(val, arena);
+        field.try_push(val, arena)
+    }
+
+    /// Appends an empty element to a repeated message field stored inline. It is a copy
+    /// of an object of this table recycled by `reuse_clear` when the arena has one, which
+    /// keeps the memory it references, and zeroed otherwise.
+    pub(crate) fn add_inline_object(
+        &mut self,
+        offset: u32,
+        table: &Table,
+        arena: &mut Arena,
+    ) -> Result<&'static mut Object, AllocError> {
+        let field = self.ref_mut::<RawRepeatedField>(offset);
+        let elem = field.try_push_uninit(inline_layout(table), arena)?;
+        let size = table.size as usize;
+        unsafe {
+            match arena.take_recycled(object_key(table)) {
+                Some(object) => {
+                    core::ptr::copy_nonoverlapping(object, elem, size);
+                    arena.recycle(spare_key(table), object);
+                }
+                None => core::ptr::write_bytes(elem, 0, size),
+            }
+            Ok(&mut *(elem as *mut Object))
+        }
     }
 
     pub(crate) fn bytes(&self, offset: usize) -> &[u8] {
@@ -90,17 +487,119 @@ impl Object {
         has_bit_idx: u32,
         bytes: &[u8],
         arena: &mut Arena,
-    ) -> &mut Bytes {
+    ) -> Result<&mut Bytes, AllocError> {
         self.set_has_bit(has_bit_idx);
         let field = self.ref_mut::<Bytes>(offset);
-        field.assign(bytes, arena);
-        field
+        field.try_assign(bytes, arena)?;
+        Ok(field)
     }
 
-    pub(crate) fn add_bytes(&mut self, offset: u32, bytes: &[u8], arena: &mut Arena) -> &mut Bytes {
+    pub(crate) fn add_bytes(
+        &mut self,
+        offset: u32,
+        bytes: &[u8],
+        arena: &mut Arena,
+    ) -> Result<&mut Bytes, AllocError> {
         let field = self.ref_mut::<RepeatedField<Bytes>>(offset);
-        let b = Bytes::from_slice(bytes, arena);
-        field.push(b, arena);
-        field.last_mut().unwrap()
+        let b = new_bytes(bytes, arena)?;
+        field.try_push(b, arena)?;
+        Ok(field.last_mut().unwrap())
+    }
+}
+
+// Layout of an element of a repeated message field stored inline. Elements follow each
+// other at a stride of `table.size`, which is a multiple of the alignment of their fields.
+fn inline_layout(table: &Table) -> Layout {
+    unsafe { Layout::from_size_align_unchecked(table.size as usize, core::mem::align_of::<u64>()) }
+}
+
+/// The elements of a repeated message field, either pointers to separately allocated
+/// objects or, for `FieldKind::RepeatedInlineMessage`, the objects themselves.
+#[derive(Clone, Copy)]
+pub(crate) struct RepeatedObjects<'a> {
+    ptr: *const u8,
+    len: usize,
+    // Distance between inline elements, pointers are stored when None
+    stride: Option<usize>,
+    phantom: core::marker::PhantomData<&'a Object>,
+}
+
+impl<'a> RepeatedObjects<'a> {
+    pub(crate) fn new(obj: &'a Object, kind: FieldKind, offset: u32, table: &Table) -> Self {
+        let field = obj.ref_at::<RawRepeatedField>(offset as usize);
+        RepeatedObjects {
+            ptr: field.as_ptr(),
+            len: field.len(),
+            stride: if kind == FieldKind::RepeatedInlineMessage {
+                Some(table.size as usize)
+            } else {
+                None
+            },
+            phantom: core::marker::PhantomData,
+        }
     }
+
+    pub(crate) fn len(&self) -> usize {
+        self.len
+    }
+
+    #[inline(always)]
+    pub(crate) fn get(&self, index: usize) -> &'a Object {
+        assert!(index < self.len, "index out of bounds");
+        unsafe {
+            match self.stride {
+                Some(stride) => &*(self.ptr.add(index * stride) as *const Object),
+                None => &**(self.ptr as *const *const Object).add(index),
+            }
+        }
+    }
+}
+
+// Clears a submessage and hands it to the arena for reuse by `Object::try_create_for`.
+unsafe fn recycle_object(object: *mut Object, table: &Table, arena: &mut Arena) {
+    unsafe {
+        (*object).reuse_clear(table, arena);
+        arena.recycle(object_key(table), object as *mut u8);
+    }
+}
+
+// Hands a copy of a cleared inline element to the arena, like `recycle_object`. The copy
+// goes to spare object memory when there is some.
+unsafe fn recycle_copy(object: *const Object, table: &Table, arena: &mut Arena) {
+    let copy = match arena.take_recycled(spare_key(table)) {
+        Some(copy) => copy,
+        None => match Object::try_create(table.size as u32, arena) {
+            Ok(copy) => copy as *mut Object as *mut u8,
+            // Recycling is best effort
+            Err(_) => return,
+        },
+    };
+    unsafe {
+        core::ptr::copy_nonoverlapping(object as *const u8, copy, table.size as usize);
+        arena.recycle(object_key(table), copy);
+    }
+}
+
+// A copy of `bytes` for an element of a repeated bytes field. While the arena recycles
+// memory, the copy goes to a recycled buffer when there is one. New buffers then get a
+// power of two capacity, so they are reused by payloads of similar size later on.
+pub(crate) fn new_bytes(bytes: &[u8], arena: &mut Arena) -> Result<Bytes, AllocError> {
+    if bytes.is_empty() || !arena.is_recycling() {
+        return Bytes::try_from_slice(bytes, arena);
+    }
+    let class = bytes
+        .len()
+        .next_power_of_two()
+        .trailing_zeros()
+        .max(MIN_BUFFER_CLASS);
+    let mut b = match arena.take_recycled(buffer_key(class)) {
+        Some(buffer) => unsafe { Bytes::from_raw_buffer(buffer, 1 << class) },
+        None => {
+            let mut b = Bytes::new();
+            b.try_reserve(1 << class, arena)?;
+            b
+        }
+    };
+    b.try_append(bytes, arena)?;
+    Ok(b)
 }
@@ -0,0 +1,280 @@
+use std::alloc::{AllocError, Allocator, Layout};
+use std::ops::{Deref, DerefMut};
+use std::ptr::NonNull;
+use std::sync::Mutex;
+
+use crate::arena::{Arena, GrowthPolicy, NestedArena, SendArena};
+
+/// An arena that several threads allocate from at once, to build one message tree in
+/// parallel. Each thread allocates through its own `ArenaHandle`, a plain arena that bump
+/// allocates from its current block, so allocating costs the same as with a single
+/// threaded arena. Handles refill their blocks from a block source shared by all handles,
+/// which carves them from large blocks under a lock, so the allocator is only called for
+/// a large block now and then. A handle derefs to `Arena`, and is accepted wherever
+/// `&mut Arena` is.
+///
+/// When a handle is dropped its arena is fused into the shared arena, so everything
+/// allocated through any handle lives as long as the `ConcurrentArena`. A handle whose
+/// arena was replaced by one with another allocator drops that arena instead. Memory a
+/// handle releases by resetting is only freed with the `ConcurrentArena`.
+pub struct ConcurrentArena<'a> {
+    policy: GrowthPolicy,
+    arena: Mutex<SendArena<'a>>,
+    // Lives in the memory of the shared arena. Handles compare their allocator against
+    // this pointer, so it is coerced to a trait object once.
+    source: NonNull<dyn Allocator + Sync>,
+}
+
+// Safety: The block source is Sync and owned by the shared arena, which is Send
+unsafe impl Send for ConcurrentArena<'_> {}
+unsafe impl Sync for ConcurrentArena<'_> {}
+
+// Hands out the blocks of handles. It lives in the memory of the shared arena and carves
+// the blocks from an arena nested in it, which the shared arena drops after the handle
+// arenas fused into it, as it was nested first.
+struct BlockSource {
+    lock: Mutex<()>,
+    blocks: NestedArena,
+}
+
+// Safety: The nested arena is only used under the lock, and its allocator is Sync
+unsafe impl Sync for BlockSource {}
+
+unsafe impl Allocator for BlockSource {
+    fn allocate(&self, layout: Layout) -> Result<NonNull<[u8]>, AllocError> {
+        let _guard = self.lock.lock().unwrap();
+        let ptr = unsafe { self.blocks.get() }.try_lend(layout)?;
+        Ok(NonNull::slice_from_raw_parts(ptr, layout.size()))
+    }
+
+    unsafe fn deallocate(&self, _ptr: NonNull<u8>, _layout: Layout) {
+        // Freed together with the large block it was carved from
+    }
+}
+
+impl<'a> ConcurrentArena<'a> {
+    pub fn new(allocator: &'a (dyn Allocator + Sync)) -> Self {
+        Self::with_policy(allocator, GrowthPolicy::DEFAULT)
+    }
+
+    /// Create a concurrent arena whose handles grow their blocks according to `policy`.
+    /// The shared blocks they are carved from have the maximum block size.
+    pub fn with_policy(allocator: &'a (dyn Allocator + Sync), policy: GrowthPolicy) -> Self {
+        let mut arena = Arena::new(allocator);
+        let source = arena.alloc::<BlockSource>();
+        unsafe {
+            (&raw mut (*source).lock).write(Mutex::new(()));
+            arena
+                .init_nested(&raw mut (*source).blocks, 0)
+                .expect("Allocation failed");
+            (*source).blocks.get().set_growth_policy(GrowthPolicy {
+                initial_block_size: policy.max_block_size,
+                ..policy
+            });
+        }
+        ConcurrentArena {
+            policy,
+            arena: Mutex::new(SendArena(arena)),
+            source: unsafe { NonNull::new_unchecked(source as *mut (dyn Allocator + Sync)) },
+        }
+    }
+
+    fn source(&self) -> &(dyn Allocator + Sync) {
+        unsafe { self.source.as_ref() }
+    }
+
+    /// Returns an arena for the calling thread to allocate from.
+    pub fn handle(&self) -> ArenaHandle<'_, 'a> {
+        ArenaHandle {
+            arena: Arena::with_policy(self.source(), self.policy),
+            shared: self,
+        }
+    }
+
+    /// Get total bytes allocated by the arena, including handles that were dropped
+    pub fn bytes_allocated(&self) -> usize {
+        self.arena.lock().unwrap().0.bytes_allocated()
+    }
+
+    /// Turns the arena into a single threaded arena that owns all memory allocated
+    /// through its handles.
+    pub fn into_arena(self) -> Arena<'a> {
+        self.arena.into_inner().unwrap().0
+    }
+}
+
+/// A thread's view of a `ConcurrentArena`.
+pub struct ArenaHandle<'c, 'a> {
+    arena: Arena<'c>,
+    shared: &'c ConcurrentArena<'a>,
+}
+
+impl<'c> Deref for ArenaHandle<'c, '_> {
+    type Target = Arena<'c>;
+
+    fn deref(&self) -> &Arena<'c> {
+        &self.arena
+    }
+}
+
+impl<'c> DerefMut for ArenaHandle<'c, '_> {
+    fn deref_mut(&mut self) -> &mut Arena<'c> {
+        &mut self.arena
+    }
+}
+
+impl Drop for ArenaHandle<'_, '_> {
+    fn drop(&mut self) {
+        let source = self.shared.source();
+        // The shared arena may be dropped on another thread, so it only takes arenas with
+        // the Sync block source
+        if !self.arena.uses_allocator(source) {
+            return;
+        }
+        let arena = core::mem::replace(&mut self.arena, Arena::new(source));
+        // SAFETY: The block source lives in the shared arena, which drops the arenas fused
+        // into it before its own blocks.
+        let arena: Arena<'_> = unsafe { core::mem::transmute(arena) };
+        self.shared.arena.lock().unwrap().0.fuse(arena);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::containers::RepeatedField;
+    use std::alloc::Global;
+    use std::sync::atomic::{AtomicUsize, Ordering};
+
+    struct CountingAllocator(AtomicUsize);
+
+    unsafe impl Allocator for CountingAllocator {
+        fn allocate(&self, layout: Layout) -> Result<NonNull<[u8]>, AllocError> {
+            self.0.fetch_add(1, Ordering::Relaxed);
+            Global.allocate(layout)
+        }
+
+        unsafe fn deallocate(&self, ptr: NonNull<u8>, layout: Layout) {
+            unsafe { Global.deallocate(ptr, layout) }
+        }
+    }
+
+    #[test]
+    fn test_concurrent_arena() {
+        let arena = ConcurrentArena::new(&Global);
+        let parts = std::thread::scope(|scope| {
+            let threads: Vec<_> = (0..4u64)
+                .map(|i| {
+                    let arena = &arena;
+                    scope.spawn(move || {
+                        let mut handle = arena.handle();
+                        let mut field = RepeatedField::new();
+                        for j in 0..25_000 {
+                            field.push(i * 25_000 + j, &mut handle);
+                        }
+                        // Raw parts, as fields are not Send
+                        (field.as_ptr() as usize, field.len())
+                    })
+                })
+                .collect();
+            threads
+                .into_iter()
+                .map(|t| t.join().unwrap())
+                .collect::<Vec<_>>()
+        });
+        assert!(arena.bytes_allocated() >= 100_000 * 8);
+
+        // The memory of all handles is owned by the merged arena
+        let arena = arena.into_arena();
+        let values = parts
+            .iter()
+            .flat_map(|&(ptr, len)| unsafe { core::slice::from_raw_parts(ptr as *const u64, len) });
+        assert!(values.copied().eq(0..100_000));
+        drop(arena);
+    }
+
+    #[test]
+    fn test_parallel_message_tree() {
+        use crate::google::protobuf::{DescriptorProto, FileDescriptorProto};
+
+        let arena = ConcurrentArena::new(&Global);
+        let mut handle = arena.handle();
+        let file = handle.place(FileDescriptorProto::ProtoType::default());
+        file.set_name("parallel.proto", &mut handle);
+        std::thread::scope(|scope| {
+            let threads: Vec<_> = (0..4)
+                .map(|i| {
+                    let arena = &arena;
+                    scope.spawn(move || {
+                        let mut handle = arena.handle();
+                        let message = handle.place(DescriptorProto::ProtoType::default());
+                        message.set_name(&format!("Message{i}"), &mut handle);
+                        for j in 0..1000 {
+                            let field = message.add_field(&mut handle);
+                            field.set_name(&format!("field{j}"), &mut handle);
+                            field.set_number(j + 1);
+                        }
+                        // A raw pointer, as messages are not Send
+                        message as *mut DescriptorProto::ProtoType as usize
+                    })
+                })
+                .collect();
+            // Link the subtrees into the tree of this thread as they are done
+            for thread in threads {
+                let message = thread.join().unwrap() as *mut DescriptorProto::ProtoType;
+                file.message_type_mut()
+                    .push(unsafe { &mut *message }, &mut handle);
+            }
+        });
+        let file = file as *const FileDescriptorProto::ProtoType;
+        drop(handle);
+
+        // The whole tree is owned by the merged arena
+        let arena = arena.into_arena();
+        let file = unsafe { &*file };
+        assert_eq!(file.name(), "parallel.proto");
+        assert_eq!(file.message_type().len(), 4);
+        for (i, message) in file.message_type().iter().enumerate() {
+            assert_eq!(message.name(), format!("Message{i}"));
+            assert_eq!(message.field().len(), 1000);
+            assert_eq!(message.field()[999].name(), "field999");
+            assert_eq!(message.field()[999].number(), 1000);
+        }
+        drop(arena);
+    }
+
+    #[test]
+    fn test_handles_share_blocks() {
+        let allocator = CountingAllocator(AtomicUsize::new(0));
+        let arena = ConcurrentArena::new(&allocator);
+        let before = allocator.0.load(Ordering::Relaxed);
+        std::thread::scope(|scope| {
+            for _ in 0..8 {
+                let arena = &arena;
+                scope.spawn(move || {
+                    let mut handle = arena.handle();
+                    handle.alloc::<u64>();
+                });
+            }
+        });
+        // All handles carve their first block from one shared block
+        assert_eq!(allocator.0.load(Ordering::Relaxed) - before, 1);
+    }
+
+    #[test]
+    fn test_replaced_handle_arena() {
+        let arena = ConcurrentArena::new(&Global);
+        let before = arena.bytes_allocated();
+        {
+            let mut handle = arena.handle();
+            *handle = Arena::new(&std::alloc::System);
+            handle.alloc::<u64>();
+        }
+        // The arena with another allocator is dropped, not fused
+        assert_eq!(arena.bytes_allocated(), before);
+        let mut handle = arena.handle();
+        handle.alloc::<u64>();
+        drop(handle);
+        assert!(arena.bytes_allocated() > before);
+    }
+}
@@ -1,4 +1,4 @@
-use core::alloc::Layout;
+use core::alloc::{AllocError, Layout};
 use core::fmt::Debug;
 use core::marker::PhantomData;
 use core::mem;
@@ -25,10 +25,20 @@ impl RawVec {
     }
 
     #[inline(never)]
-    fn grow(mut self, new_cap: usize, layout: Layout, arena: &mut crate::arena::Arena) -> Self {
-        // since we set the capacity to usize::MAX when T has size 0,
-        // getting to here necessarily means the Vec is overfull.
-        assert!(layout.size() != 0, "capacity overflow");
+    fn grow(
+        mut self,
+        new_cap: usize,
+        layout: Layout,
+        arena: &mut crate::arena::Arena,
+    ) -> Result<Self, AllocError> {
+        if layout.size() == 0 {
+            // Zero sized elements, e.g. inline empty messages, never need memory. Any
+            // aligned address holds as many as fit in usize.
+            assert!(self.cap == 0, "capacity overflow");
+            self.ptr = ptr::without_provenance_mut(layout.align());
+            self.cap = usize::MAX;
+            return Ok(self);
+        }
 
         let (new_cap, new_layout) = if self.cap == 0 {
             if new_cap == 0 {
@@ -60,21 +70,19 @@ impl RawVec {
         );
 
         let new_ptr = if self.cap == 0 {
-            arena.alloc_raw(new_layout).as_ptr()
+            arena.try_alloc_raw(new_layout)?.as_ptr()
+        } else if arena.try_extend_in_place(self.ptr, layout.size() * self.cap, new_layout.size()) {
+            // Still the last allocation in the arena, e.g. a repeated field being decoded
+            self.ptr
         } else {
-            let new_ptr = arena.alloc_raw(new_layout).as_ptr();
+            let new_ptr = arena.try_alloc_raw(new_layout)?.as_ptr();
             unsafe { core::ptr::copy_nonoverlapping(self.ptr, new_ptr, layout.size() * self.cap) };
             new_ptr
         };
 
-        // If allocation fails, `new_ptr` will be null, in which case we abort.
-        if new_ptr.is_null() {
-            // TODO: use a better error handling strategy
-            panic!("allocation failed");
-        }
         self.ptr = new_ptr;
         self.cap = new_cap;
-        self
+        Ok(self)
     }
 
     #[allow(dead_code)]
@@ -87,7 +95,7 @@ impl RawVec {
     ) -> *mut u8 {
         let l = *len;
         if l == self.cap {
-            *self = self.grow(0, layout, arena);
+            *self = self.grow(0, layout, arena).expect("Allocation failed");
         }
 
         // Can't overflow, we'll OOM first.
@@ -108,10 +116,16 @@ impl RawVec {
         }
     }
 
-    pub fn reserve(&mut self, new_cap: usize, layout: Layout, arena: &mut crate::arena::Arena) {
+    pub fn reserve(
+        &mut self,
+        new_cap: usize,
+        layout: Layout,
+        arena: &mut crate::arena::Arena,
+    ) -> Result<(), AllocError> {
         if new_cap > self.cap {
-            *self = self.grow(new_cap, layout, arena);
+            *self = self.grow(new_cap, layout, arena)?;
         }
+        Ok(())
     }
 }
 
@@ -122,6 +136,44 @@ pub struct RepeatedField<T> {
     phantom: core::marker::PhantomData<T>,
 }
 
+// A repeated field whose element layout is only known at runtime, with the same layout
+// as any `RepeatedField`. Used for repeated messages stored inline, whose elements are
+// objects of `Table::size` bytes.
+#[repr(C)]
+pub(crate) struct RawRepeatedField {
+    buf: RawVec,
+    len: usize,
+}
+
+impl RawRepeatedField {
+    pub(crate) fn len(&self) -> usize {
+        self.len
+    }
+
+    pub(crate) fn as_ptr(&self) -> *mut u8 {
+        self.buf.ptr
+    }
+
+    // Appends an uninitialized element of `layout` and returns a pointer to it.
+    #[inline(always)]
+    pub(crate) fn try_push_uninit(
+        &mut self,
+        layout: Layout,
+        arena: &mut crate::arena::Arena,
+    ) -> Result<*mut u8, AllocError> {
+        let l = self.len;
+        if l == self.buf.cap {
+            self.buf = self.buf.grow(0, layout, arena)?;
+        }
+        self.len = l + 1;
+        Ok(unsafe { self.buf.ptr.add(l * layout.size()) })
+    }
+
+    pub(crate) fn clear(&mut self) {
+        self.len = 0;
+    }
+}
+
 impl<T: PartialEq> PartialEq for RepeatedField<T> {
     fn eq(&self, other: &Self) -> bool {
         self.as_ref() == other.as_ref()
@@ -169,12 +221,19 @@ impl<T> RepeatedField<T> {
     }
 
     pub fn from_slice(slice: &[T], arena: &mut crate::arena::Arena) -> Self
+    where
+        T: Copy,
+    {
+        Self::try_from_slice(slice, arena).expect("Allocation failed")
+    }
+
+    pub fn try_from_slice(slice: &[T], arena: &mut crate::arena::Arena) -> Result<Self, AllocError>
     where
         T: Copy,
     {
         let mut rf = Self::new();
-        rf.append(slice, arena);
-        rf
+        rf.try_append(slice, arena)?;
+        Ok(rf)
     }
 
     pub const fn from_static(slice: &'static [T]) -> Self {
@@ -188,6 +247,20 @@ impl<T> RepeatedField<T> {
         }
     }
 
+    // Points the field at memory it does not own, without copying. The caller guarantees
+    // the slice outlives the field and that the field is not written through; growing it
+    // copies into the arena as for from_static.
+    pub(crate) unsafe fn alias(slice: &[T]) -> Self {
+        RepeatedField {
+            buf: RawVec {
+                ptr: slice.as_ptr() as *mut u8,
+                cap: slice.len(),
+            },
+            len: slice.len(),
+            phantom: PhantomData,
+        }
+    }
+
     pub const fn slice(&self) -> &[T] {
         if self.cap() == 0 {
             &[]
@@ -206,14 +279,22 @@ impl<T> RepeatedField<T> {
 
     #[inline(always)]
     pub fn push(&mut self, elem: T, arena: &mut crate::arena::Arena) {
+        self.try_push(elem, arena).expect("Allocation failed")
+    }
+
+    /// Like `push`, but returns an error instead of panicking when the arena cannot grow
+    /// the field. The element is dropped in that case.
+    #[inline(always)]
+    pub fn try_push(&mut self, elem: T, arena: &mut crate::arena::Arena) -> Result<(), AllocError> {
         let l = self.len;
         if l == self.cap() {
-            self.buf = self.buf.grow(0, Layout::new::<T>(), arena);
+            self.buf = self.buf.grow(0, Layout::new::<T>(), arena)?;
         }
         unsafe { self.ptr().add(l).write(elem) };
 
         // Can't overflow, we'll OOM first.
         self.len = l + 1;
+        Ok(())
     }
 
     pub fn pop(&mut self) -> Option<T> {
@@ -228,7 +309,10 @@ impl<T> RepeatedField<T> {
         assert!(index <= self.len, "index out of bounds");
         let len = self.len;
         if len == self.cap() {
-            self.buf = self.buf.grow(0, Layout::new::<T>(), arena);
+            self.buf = self
+                .buf
+                .grow(0, Layout::new::<T>(), arena)
+                .expect("Allocation failed");
         }
 
         unsafe {
@@ -281,29 +365,94 @@ impl<T> RepeatedField<T> {
     }
 
     pub fn reserve(&mut self, new_cap: usize, arena: &mut crate::arena::Arena) {
-        self.buf.reserve(new_cap, Layout::new::<T>(), arena);
+        self.try_reserve(new_cap, arena).expect("Allocation failed")
+    }
+
+    pub fn try_reserve(
+        &mut self,
+        new_cap: usize,
+        arena: &mut crate::arena::Arena,
+    ) -> Result<(), AllocError> {
+        self.buf.reserve(new_cap, Layout::new::<T>(), arena)
+    }
+
+    // Makes room for additional elements and returns a pointer to the uninitialized
+    // space after the current elements. The caller writes the elements and then commits
+    // them with set_len.
+    pub(crate) fn reserve_tail(
+        &mut self,
+        additional: usize,
+        arena: &mut crate::arena::Arena,
+    ) -> Result<*mut T, AllocError> {
+        self.try_reserve(self.len + additional, arena)?;
+        Ok(unsafe { self.ptr().add(self.len) })
+    }
+
+    pub(crate) fn capacity(&self) -> usize {
+        self.cap()
+    }
+
+    // An empty field that stores its elements in `ptr`, which has room for `cap` of them.
+    // The caller guarantees the memory is owned by the arena and not used otherwise.
+    pub(crate) unsafe fn from_raw_buffer(ptr: *mut T, cap: usize) -> Self {
+        RepeatedField {
+            buf: RawVec {
+                ptr: ptr as *mut u8,
+                cap,
+            },
+            len: 0,
+            phantom: PhantomData,
+        }
+    }
+
+    pub(crate) unsafe fn set_len(&mut self, len: usize) {
+        debug_assert!(len <= self.cap());
+        self.len = len;
     }
 
     pub fn assign(&mut self, slice: &[T], arena: &mut crate::arena::Arena)
+    where
+        T: Copy,
+    {
+        self.try_assign(slice, arena).expect("Allocation failed")
+    }
+
+    pub fn try_assign(
+        &mut self,
+        slice: &[T],
+        arena: &mut crate::arena::Arena,
+    ) -> Result<(), AllocError>
     where
         T: Copy,
     {
         self.clear();
-        self.append(slice, arena);
+        self.try_append(slice, arena)
     }
 
     pub fn append(&mut self, slice: &[T], arena: &mut crate::arena::Arena)
+    where
+        T: Copy,
+    {
+        self.try_append(slice, arena).expect("Allocation failed")
+    }
+
+    pub fn try_append(
+        &mut self,
+        slice: &[T],
+        arena: &mut crate::arena::Arena,
+    ) -> Result<(), AllocError>
     where
         T: Copy,
     {
         let old_len = self.len;
-        self.reserve(old_len + slice.len(), arena);
+        self.try_reserve(old_len + slice.len(), arena)?;
         unsafe {
             self.ptr()
                 .add(old_len)
                 .copy_from_nonoverlapping(slice.as_ptr(), slice.len());
         }
         self.len = old_len + slice.len();
+        Ok(())
     }
 }
 
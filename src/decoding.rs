@@ -2,11 +2,13 @@ use core::mem::MaybeUninit;
 use core::ptr::NonNull;
 
 use crate::ProtobufMut;
-use crate::base::Object;
+use crate::base::{LazyMessage, LazyObject, Object, new_bytes};
 use crate::containers::{Bytes, RepeatedField};
 use crate::tables::{AuxTableEntry, Table};
 use crate::utils::{Stack, StackWithStorage};
-use crate::wire::{FieldKind, ReadCursor, SLOP_SIZE, zigzag_decode};
+use crate::wire::{
+    FieldKind, ReadCursor, SLOP_SIZE, validate_utf8, validate_utf8_prefix, zigzag_decode,
+};
 
 const TRACE_TAGS: bool = false;
 
@@ -51,6 +53,555 @@ impl Table {
         let offset = entry.aux_offset();
         self.aux_entry(offset as usize)
     }
+
+    // The slot is selected by bits 3..7 of the first tag byte, i.e. the field number for
+    // one byte tags and 16 + the low 4 bits of the field number for two byte tags.
+    #[inline(always)]
+    pub(crate) fn fast_entry(&self, raw_tag: u32) -> &FastEntry {
+        &self.fast_entries()[((raw_tag & 0xf8) >> 3) as usize]
+    }
+}
+
+pub const NUM_FAST_ENTRIES: usize = 32;
+
+type FastHandler =
+    fn(&mut Object, ReadCursor, NonNull<u8>, &FastEntry, &mut crate::arena::Arena) -> ReadCursor;
+
+// Fast dispatch slot. The decoder peeks the first two bytes of the tag, selects a slot
+// and calls its handler, which is specialized for the field kind, wire type and tag
+// width, and checks the expected tag with a single compare. A handler that cannot
+// decode the field (tag mismatch, field spans the buffer end, malformed input) returns
+// the cursor unchanged and the generic decode loop takes over.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct FastEntry {
+    handler: FastHandler,
+    tag: u16,
+    entry: TableEntry,
+}
+
+impl FastEntry {
+    pub const EMPTY: FastEntry = FastEntry {
+        handler: fast_fallback,
+        tag: 0,
+        entry: TableEntry(0),
+    };
+
+    pub const fn new(encoded_tag: u32, entry: TableEntry) -> Self {
+        let handler = match fast_handler(entry.0 as u8, encoded_tag) {
+            Some(handler) => handler,
+            None => fast_fallback,
+        };
+        // The tag as it appears on the wire, read little endian.
+        let tag = if encoded_tag < 0x80 {
+            encoded_tag
+        } else {
+            (encoded_tag & 0x7f) | 0x80 | ((encoded_tag >> 7) << 8)
+        };
+        FastEntry {
+            handler,
+            tag: tag as u16,
+            entry,
+        }
+    }
+
+    #[inline(always)]
+    fn matches<const TAG_BYTES: usize>(&self, cursor: ReadCursor) -> bool {
+        let mask = if TAG_BYTES == 1 { 0xff } else { 0xffff };
+        (cursor.peek_tag() ^ self.tag as u32) & mask == 0
+    }
+}
+
+#[cfg(test)]
+impl PartialEq for FastEntry {
+    fn eq(&self, other: &Self) -> bool {
+        self.tag == other.tag && self.entry.0 == other.entry.0
+    }
+}
+
+// Returns the fast table slot for a field, or None if the field has no fast handler.
+// When several fields map to the same slot the one with the lowest field number wins.
+pub fn fast_slot(kind: FieldKind, encoded_tag: u32) -> Option<usize> {
+    fast_handler(kind as u8, encoded_tag)?;
+    let field_number = encoded_tag >> 3;
+    if field_number < 16 {
+        Some(field_number as usize)
+    } else {
+        Some(16 + (field_number & 15) as usize)
+    }
+}
+
+const fn fast_handler(kind: u8, encoded_tag: u32) -> Option<FastHandler> {
+    let field_number = encoded_tag >> 3;
+    if field_number == 0 || field_number >= 2048 {
+        return None;
+    }
+    if encoded_tag < 0x80 {
+        fast_handler_for_width::<1>(kind, encoded_tag & 7)
+    } else {
+        fast_handler_for_width::<2>(kind, encoded_tag & 7)
+    }
+}
+
+const fn fast_handler_for_width<const TAG_BYTES: usize>(
+    kind: u8,
+    wire_type: u32,
+) -> Option<FastHandler> {
+    let kind: FieldKind = unsafe { core::mem::transmute(kind) };
+    let handler: FastHandler = match (kind, wire_type) {
+        (FieldKind::Varint64, 0) => fast_varint64::<TAG_BYTES>,
+        (FieldKind::Varint32 | FieldKind::Int32, 0) => fast_varint32::<TAG_BYTES>,
+        (FieldKind::Varint64Zigzag, 0) => fast_varint64_zigzag::<TAG_BYTES>,
+        (FieldKind::Varint32Zigzag, 0) => fast_varint32_zigzag::<TAG_BYTES>,
+        (FieldKind::Bool, 0) => fast_bool::<TAG_BYTES>,
+        (FieldKind::BoolBit, 0) => fast_bool_bit::<TAG_BYTES>,
+        (FieldKind::Fixed64, 1) => fast_fixed64::<TAG_BYTES>,
+        (FieldKind::Fixed32, 5) => fast_fixed32::<TAG_BYTES>,
+        (FieldKind::Bytes, 2) => fast_bytes::<TAG_BYTES>,
+        (FieldKind::String, 2) => fast_string::<TAG_BYTES>,
+        (FieldKind::RepeatedVarint64, 0) => fast_repeated_varint64::<TAG_BYTES>,
+        (FieldKind::RepeatedVarint32 | FieldKind::RepeatedInt32, 0) => {
+            fast_repeated_varint32::<TAG_BYTES>
+        }
+        (FieldKind::RepeatedVarint64Zigzag, 0) => fast_repeated_varint64_zigzag::<TAG_BYTES>,
+        (FieldKind::RepeatedVarint32Zigzag, 0) => fast_repeated_varint32_zigzag::<TAG_BYTES>,
+        (FieldKind::RepeatedBool, 0) => fast_repeated_bool::<TAG_BYTES>,
+        (FieldKind::RepeatedFixed64, 1) => fast_repeated_fixed64::<TAG_BYTES>,
+        (FieldKind::RepeatedFixed32, 5) => fast_repeated_fixed32::<TAG_BYTES>,
+        (FieldKind::RepeatedBytes, 2) => fast_repeated_bytes::<TAG_BYTES>,
+        (FieldKind::RepeatedString, 2) => fast_repeated_string::<TAG_BYTES>,
+        (FieldKind::RepeatedVarint64, 2) => fast_packed_varint64::<TAG_BYTES>,
+        (FieldKind::RepeatedVarint32 | FieldKind::RepeatedInt32, 2) => {
+            fast_packed_varint32::<TAG_BYTES>
+        }
+        (FieldKind::RepeatedVarint64Zigzag, 2) => fast_packed_varint64_zigzag::<TAG_BYTES>,
+        (FieldKind::RepeatedVarint32Zigzag, 2) => fast_packed_varint32_zigzag::<TAG_BYTES>,
+        (FieldKind::RepeatedBool, 2) => fast_packed_bool::<TAG_BYTES>,
+        (FieldKind::RepeatedFixed64, 2) => fast_packed_fixed::<u64, TAG_BYTES>,
+        (FieldKind::RepeatedFixed32, 2) => fast_packed_fixed::<u32, TAG_BYTES>,
+        _ => return None,
+    };
+    Some(handler)
+}
+
+fn fast_fallback(
+    _obj: &mut Object,
+    cursor: ReadCursor,
+    _limited_end: NonNull<u8>,
+    _slot: &FastEntry,
+    _arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    cursor
+}
+
+#[inline(always)]
+fn fast_set<T, const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    slot: &FastEntry,
+    read: impl FnOnce(&mut ReadCursor) -> Option<T>,
+) -> ReadCursor {
+    if !slot.matches::<TAG_BYTES>(cursor) {
+        return cursor;
+    }
+    let mut next = cursor + TAG_BYTES as isize;
+    let Some(val) = read(&mut next) else {
+        return cursor;
+    };
+    obj.set(slot.entry.offset(), slot.entry.has_bit_idx(), val);
+    next
+}
+
+// Repeated fields are usually encoded back to back, so keep consuming elements as long
+// as the next tag is the same.
+#[inline(always)]
+fn fast_add<T, const TAG_BYTES: usize>(
+    obj: &mut Object,
+    mut cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+    read: impl Fn(&mut ReadCursor, &mut crate::arena::Arena) -> Option<T>,
+) -> ReadCursor {
+    let field = obj.ref_mut::<RepeatedField<T>>(slot.entry.offset());
+    while cursor < limited_end && slot.matches::<TAG_BYTES>(cursor) {
+        let mut next = cursor + TAG_BYTES as isize;
+        let Some(val) = read(&mut next, arena) else {
+            break;
+        };
+        // Allocation failures are left to the generic path, which fails the decode
+        if field.try_push(val, arena).is_err() {
+            break;
+        }
+        cursor = next;
+    }
+    cursor
+}
+
+#[inline(always)]
+fn fast_packed<T, const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+    unpack: impl FnOnce(
+        &mut RepeatedField<T>,
+        ReadCursor,
+        NonNull<u8>,
+        &mut crate::arena::Arena,
+    ) -> Option<ReadCursor>,
+) -> ReadCursor {
+    if !slot.matches::<TAG_BYTES>(cursor) {
+        return cursor;
+    }
+    let mut next = cursor + TAG_BYTES as isize;
+    let Some(len) = next.read_size() else {
+        return cursor;
+    };
+    if next - limited_end + len > 0 {
+        return cursor;
+    }
+    let span_end = (next + len).0;
+    let field = obj.ref_mut::<RepeatedField<T>>(slot.entry.offset());
+    match unpack(field, next, span_end, arena) {
+        Some(next) if next == span_end => next,
+        _ => cursor,
+    }
+}
+
+#[inline(always)]
+fn read_bytes<'b>(cursor: &'b mut ReadCursor, limited_end: NonNull<u8>) -> Option<&'b [u8]> {
+    let len = cursor.read_size()?;
+    if *cursor - limited_end + len > SLOP_SIZE as isize {
+        return None;
+    }
+    Some(cursor.read_slice(len))
+}
+
+fn fast_varint64<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    _limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    _arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_set::<_, TAG_BYTES>(obj, cursor, slot, |c| c.read_varint())
+}
+
+fn fast_varint32<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    _limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    _arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_set::<_, TAG_BYTES>(obj, cursor, slot, |c| c.read_varint32())
+}
+
+fn fast_varint64_zigzag<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    _limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    _arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_set::<_, TAG_BYTES>(obj, cursor, slot, |c| Some(zigzag_decode(c.read_varint()?)))
+}
+
+fn fast_varint32_zigzag<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    _limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    _arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_set::<_, TAG_BYTES>(obj, cursor, slot, |c| {
+        Some(zigzag_decode(c.read_varint32()? as u64) as i32)
+    })
+}
+
+fn fast_bool<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    _limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    _arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_set::<_, TAG_BYTES>(obj, cursor, slot, |c| Some(c.read_varint()? != 0))
+}
+
+fn fast_bool_bit<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    _limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    _arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    if !slot.matches::<TAG_BYTES>(cursor) {
+        return cursor;
+    }
+    let mut next = cursor + TAG_BYTES as isize;
+    let Some(val) = next.read_varint() else {
+        return cursor;
+    };
+    obj.set_has_bit(slot.entry.has_bit_idx());
+    obj.set_bit(slot.entry.offset(), val != 0);
+    next
+}
+
+fn fast_fixed64<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    _limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    _arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_set::<_, TAG_BYTES>(obj, cursor, slot, |c| Some(c.read_unaligned::<u64>()))
+}
+
+fn fast_fixed32<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    _limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    _arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_set::<_, TAG_BYTES>(obj, cursor, slot, |c| Some(c.read_unaligned::<u32>()))
+}
+
+fn fast_bytes<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    if !slot.matches::<TAG_BYTES>(cursor) {
+        return cursor;
+    }
+    let mut next = cursor + TAG_BYTES as isize;
+    let Some(slice) = read_bytes(&mut next, limited_end) else {
+        return cursor;
+    };
+    if obj
+        .set_bytes(slot.entry.offset(), slot.entry.has_bit_idx(), slice, arena)
+        .is_err()
+    {
+        return cursor;
+    }
+    next
+}
+
+// Invalid UTF-8 is left to the generic path, which fails the decode.
+fn fast_string<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    if !slot.matches::<TAG_BYTES>(cursor) {
+        return cursor;
+    }
+    let mut next = cursor + TAG_BYTES as isize;
+    let Some(slice) = read_bytes(&mut next, limited_end) else {
+        return cursor;
+    };
+    if !validate_utf8(slice) {
+        return cursor;
+    }
+    if obj
+        .set_bytes(slot.entry.offset(), slot.entry.has_bit_idx(), slice, arena)
+        .is_err()
+    {
+        return cursor;
+    }
+    next
+}
+
+fn fast_repeated_varint64<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_add::<_, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |c, _| {
+        c.read_varint()
+    })
+}
+
+fn fast_repeated_varint32<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_add::<_, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |c, _| {
+        c.read_varint32()
+    })
+}
+
+fn fast_repeated_varint64_zigzag<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_add::<_, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |c, _| {
+        Some(zigzag_decode(c.read_varint()?))
+    })
+}
+
+fn fast_repeated_varint32_zigzag<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_add::<_, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |c, _| {
+        Some(zigzag_decode(c.read_varint32()? as u64) as i32)
+    })
+}
+
+fn fast_repeated_bool<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_add::<_, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |c, _| {
+        Some(c.read_varint()? != 0)
+    })
+}
+
+fn fast_repeated_fixed64<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_add::<_, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |c, _| {
+        Some(c.read_unaligned::<u64>())
+    })
+}
+
+fn fast_repeated_fixed32<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_add::<_, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |c, _| {
+        Some(c.read_unaligned::<u32>())
+    })
+}
+
+fn fast_repeated_bytes<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_add::<_, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |c, arena| {
+        new_bytes(read_bytes(c, limited_end)?, arena).ok()
+    })
+}
+
+fn fast_repeated_string<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_add::<_, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |c, arena| {
+        let slice = read_bytes(c, limited_end)?;
+        if !validate_utf8(slice) {
+            return None;
+        }
+        new_bytes(slice, arena).ok()
+    })
+}
+
+fn fast_packed_varint64<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_packed::<u64, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |f, c, e, a| {
+        unpack_varint_bulk(f, c, e, a, |v| v)
+    })
+}
+
+fn fast_packed_varint32<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_packed::<u32, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |f, c, e, a| {
+        unpack_varint_bulk(f, c, e, a, |v| v as u32)
+    })
+}
+
+fn fast_packed_varint64_zigzag<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_packed::<i64, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |f, c, e, a| {
+        unpack_varint_bulk(f, c, e, a, zigzag_decode)
+    })
+}
+
+fn fast_packed_varint32_zigzag<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_packed::<i32, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |f, c, e, a| {
+        unpack_varint_bulk(f, c, e, a, |v| zigzag_decode(v as u32 as u64) as i32)
+    })
+}
+
+fn fast_packed_bool<const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_packed::<bool, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |f, c, e, a| {
+        unpack_varint_bulk(f, c, e, a, |v| v != 0)
+    })
+}
+
+fn fast_packed_fixed<T, const TAG_BYTES: usize>(
+    obj: &mut Object,
+    cursor: ReadCursor,
+    limited_end: NonNull<u8>,
+    slot: &FastEntry,
+    arena: &mut crate::arena::Arena,
+) -> ReadCursor {
+    fast_packed::<T, TAG_BYTES>(obj, cursor, limited_end, slot, arena, |f, c, e, a| {
+        unpack_fixed(f, c, e, a)
+    })
 }
 
 struct StackEntry {
@@ -87,6 +638,8 @@ enum DecodeObject<'a> {
     None,
     Message(&'a mut Object, &'a Table),
     Bytes(&'a mut Bytes),
+    // A string and the length of the incomplete UTF-8 sequence at its end.
+    String(&'a mut Bytes, usize),
     SkipLengthDelimited,
     SkipGroup,
     PackedU64(&'a mut RepeatedField<u64>),
@@ -164,8 +717,8 @@ impl<'a> DecodeObjectState<'a> {
     }
 
     #[inline(always)]
-    fn add<T>(&mut self, entry: TableEntry, val: T, arena: &mut crate::arena::Arena) {
-        self.obj.add(entry.aux_offset(), val, arena);
+    fn add<T>(&mut self, entry: TableEntry, val: T, arena: &mut crate::arena::Arena) -> Option<()> {
+        self.obj.add(entry.aux_offset(), val, arena).ok()
     }
 
     #[inline(always)]
@@ -174,14 +727,52 @@ impl<'a> DecodeObjectState<'a> {
         entry: TableEntry,
         slice: &[u8],
         arena: &mut crate::arena::Arena,
-    ) -> &'a mut Bytes {
-        unsafe {
-            core::mem::transmute(self.obj.set_bytes(
-                entry.offset(),
-                entry.has_bit_idx(),
-                slice,
-                arena,
-            ))
+    ) -> Option<&'a mut Bytes> {
+        let bytes = self
+            .obj
+            .set_bytes(entry.offset(), entry.has_bit_idx(), slice, arena)
+            .ok()?;
+        Some(unsafe { core::mem::transmute::<&mut Bytes, &'a mut Bytes>(bytes) })
+    }
+
+    #[inline(always)]
+    fn set_or_alias_bytes(
+        &mut self,
+        entry: TableEntry,
+        slice: &[u8],
+        aliasing: Aliasing,
+        arena: &mut crate::arena::Arena,
+    ) -> Option<&'a mut Bytes> {
+        match aliasing {
+            Aliasing::Off => self.set_bytes(entry, slice, arena),
+            Aliasing::Copy => {
+                *self.obj.ref_mut::<Bytes>(entry.offset()) = Bytes::new();
+                self.set_bytes(entry, slice, arena)
+            }
+            Aliasing::Input => Some(unsafe {
+                core::mem::transmute(self.obj.set(
+                    entry.offset(),
+                    entry.has_bit_idx(),
+                    Bytes::alias(slice),
+                ))
+            }),
+        }
+    }
+
+    #[inline(always)]
+    fn add_or_alias_bytes(
+        &mut self,
+        entry: TableEntry,
+        slice: &[u8],
+        aliasing: Aliasing,
+        arena: &mut crate::arena::Arena,
+    ) -> Option<&'a mut Bytes> {
+        if aliasing == Aliasing::Input {
+            self.add(entry, unsafe { Bytes::alias(slice) }, arena)?;
+            let field = self.obj.ref_mut::<RepeatedField<Bytes>>(entry.offset());
+            Some(unsafe { core::mem::transmute(field.last_mut().unwrap()) })
+        } else {
+            self.add_bytes(entry, slice, arena)
         }
     }
 
@@ -191,8 +782,9 @@ impl<'a> DecodeObjectState<'a> {
         entry: TableEntry,
         slice: &[u8],
         arena: &mut crate::arena::Arena,
-    ) -> &'a mut Bytes {
-        unsafe { core::mem::transmute(self.obj.add_bytes(entry.aux_offset(), slice, arena)) }
+    ) -> Option<&'a mut Bytes> {
+        let bytes = self.obj.add_bytes(entry.aux_offset(), slice, arena).ok()?;
+        Some(unsafe { core::mem::transmute::<&mut Bytes, &'a mut Bytes>(bytes) })
     }
 
     #[inline(always)]
@@ -200,18 +792,46 @@ impl<'a> DecodeObjectState<'a> {
         &mut self,
         entry: TableEntry,
         arena: &mut crate::arena::Arena,
-    ) -> (&'a mut Object, &'a Table) {
+    ) -> Option<(&'a mut Object, &'a Table)> {
         let aux_entry = self.table.aux_entry_decode(entry);
         let field = self.obj.ref_mut::<*mut Object>(aux_entry.offset);
         let child_table = unsafe { &*aux_entry.child_table };
         let child = if (*field).is_null() {
-            let child = Object::create(child_table.size as u32, arena);
+            let child = Object::try_create_for(child_table, arena).ok()?;
             *field = child;
             child
         } else {
             unsafe { &mut **field }
         };
-        (child, child_table)
+        Some((child, child_table))
+    }
+
+    #[inline(always)]
+    fn get_inline_child_object(&mut self, entry: TableEntry) -> (&'a mut Object, &'a Table) {
+        let aux_entry = self.table.aux_entry_decode(entry);
+        self.obj.set_has_bit(entry.has_bit_idx());
+        let child = self.obj.ref_mut::<Object>(aux_entry.offset);
+        let child = unsafe { &mut *(child as *mut Object) };
+        (child, unsafe { &*aux_entry.child_table })
+    }
+
+    #[inline(always)]
+    fn get_or_create_lazy_object(
+        &mut self,
+        entry: TableEntry,
+        len: isize,
+        arena: &mut crate::arena::Arena,
+    ) -> Option<(*mut LazyObject, &'a Table)> {
+        let aux_entry = self.table.aux_entry_decode(entry);
+        let child_table = unsafe { &*aux_entry.child_table };
+        let field = self.obj.ref_mut::<LazyMessage>(aux_entry.offset);
+        if field.0.is_null() {
+            // Room for the object, plus the encoded size for the repeated fields and
+            // submessages it decodes to. Strings and bytes alias the encoding.
+            let initial_size = child_table.size as usize + len as usize;
+            field.0 = LazyObject::try_create(initial_size, arena).ok()?;
+        }
+        Some((field.0, child_table))
     }
 
     #[inline(always)]
@@ -219,58 +839,217 @@ impl<'a> DecodeObjectState<'a> {
         &mut self,
         entry: TableEntry,
         arena: &mut crate::arena::Arena,
-    ) -> (&'a mut Object, &'a Table) {
+    ) -> Option<(&'a mut Object, &'a Table)> {
         let aux_entry = self.table.aux_entry_decode(entry);
         let field = self
             .obj
             .ref_mut::<RepeatedField<*mut Object>>(aux_entry.offset);
         let child_table = unsafe { &*aux_entry.child_table };
-        let child = Object::create(child_table.size as u32, arena);
-        field.push(child, arena);
-        (child, child_table)
+        let child = Object::try_create_for(child_table, arena).ok()?;
+        field.try_push(child as *mut Object, arena).ok()?;
+        Some((child, child_table))
+    }
+
+    #[inline(always)]
+    fn add_inline_child_object(
+        &mut self,
+        entry: TableEntry,
+        arena: &mut crate::arena::Arena,
+    ) -> Option<(&'a mut Object, &'a Table)> {
+        let aux_entry = self.table.aux_entry_decode(entry);
+        let child_table = unsafe { &*aux_entry.child_table };
+        let child = self
+            .obj
+            .add_inline_object(aux_entry.offset, child_table, arena)
+            .ok()?;
+        Some((child, child_table))
     }
 }
 
-type DecodeLoopResult<'a> = Option<(ReadCursor, isize, DecodeObject<'a>)>;
+// How bytes fields are stored when decoding in aliasing mode.
+#[derive(Clone, Copy, PartialEq, Eq)]
+enum Aliasing {
+    // Copy into the arena.
+    Off,
+    // Copy into fresh arena storage, never into a previously aliased payload. Used for
+    // the patch buffer and for fields that straddle a buffer boundary.
+    Copy,
+    // Point into the input buffer.
+    Input,
+}
 
-#[inline(never)]
-fn skip_length_delimited<'a>(
+impl Aliasing {
+    fn copy(self) -> Self {
+        if self == Aliasing::Input {
+            Aliasing::Copy
+        } else {
+            self
+        }
+    }
+}
+
+// Appends the slice to the encoded bytes of a lazy field. A merged lazy field is the
+// concatenation of its occurrences, so only the first one can point into the input.
+fn append_or_alias(
+    bytes: &mut Bytes,
+    slice: &[u8],
+    aliasing: Aliasing,
+    arena: &mut crate::arena::Arena,
+) -> Option<()> {
+    if aliasing == Aliasing::Input && bytes.is_empty() {
+        *bytes = unsafe { Bytes::alias(slice) };
+    } else {
+        bytes.try_append(slice, arena).ok()?;
+    }
+    Some(())
+}
+
+// Decodes the encoded bytes of a lazy field on first access. The bytes live as long as
+// the arena of the parent message, so bytes fields of the submessage can point into them.
+pub(crate) fn decode_lazy(
+    obj: &mut Object,
+    table: &Table,
+    bytes: &[u8],
+    arena: &mut crate::arena::Arena,
+) -> bool {
+    let mut decoder = ResumeableDecode::<32>::new_from_table(obj, table, isize::MAX);
+    decoder.aliasing = true;
+    decoder.resume(bytes, arena) && decoder.finish(arena)
+}
+
+// Decoder state that is only touched off the hot path. The hot state, the cursor, the
+// buffer end, the limit and the object being decoded, is passed as arguments from one
+// decode step to the next so it stays in registers.
+struct DecodeEnv<'a, 'b, 'c> {
+    stack: &'b mut Stack<StackEntry>,
+    arena: &'b mut crate::arena::Arena<'c>,
+    aliasing: Aliasing,
+    // Length of the incomplete UTF-8 sequence at the end of the string being resumed.
+    utf8_pending: usize,
+    // Where decoding resumes with the next buffer, set by a step that runs out of input.
     limit: isize,
+    object: DecodeObject<'a>,
+    #[cfg(not(feature = "tail_calls"))]
+    next: Option<(DecodeStep<'a, 'b, 'c>, isize, *mut (), *const Table)>,
+}
+
+impl<'a, 'b, 'c> DecodeEnv<'a, 'b, 'c> {
+    fn suspend(
+        &mut self,
+        cursor: ReadCursor,
+        limit: isize,
+        object: DecodeObject<'a>,
+    ) -> Option<ReadCursor> {
+        self.limit = limit;
+        self.object = object;
+        Some(cursor)
+    }
+}
+
+// All decode steps share one signature, so that a step can hand over to the next one with
+// a tail call. The meaning of the two object pointers depends on the step.
+type DecodeStep<'a, 'b, 'c> = fn(
+    ReadCursor,
+    NonNull<u8>,
+    isize,
+    *mut (),
+    *const Table,
+    &mut DecodeEnv<'a, 'b, 'c>,
+) -> Option<ReadCursor>;
+
+// Continues with another decode step. With the tail_calls feature this is a guaranteed tail
+// call (`become`), so chains of steps run in constant native stack whatever the optimizer
+// does. Otherwise the step is handed back to the trampoline in run_steps.
+#[cfg(feature = "tail_calls")]
+macro_rules! continue_with {
+    ($step:expr, $cursor:expr, $end:expr, $limit:expr, $obj:expr, $table:expr, $env:expr) => {
+        become $step($cursor, $end, $limit, $obj, $table, $env)
+    };
+}
+
+#[cfg(not(feature = "tail_calls"))]
+macro_rules! continue_with {
+    ($step:expr, $cursor:expr, $end:expr, $limit:expr, $obj:expr, $table:expr, $env:expr) => {{
+        let env = $env;
+        env.next = Some(($step, $limit, $obj, $table));
+        return Some($cursor);
+    }};
+}
+
+#[inline(always)]
+fn run_steps<'a, 'b, 'c>(
+    step: DecodeStep<'a, 'b, 'c>,
+    cursor: ReadCursor,
+    end: NonNull<u8>,
+    limit: isize,
+    obj: *mut (),
+    table: *const Table,
+    env: &mut DecodeEnv<'a, 'b, 'c>,
+) -> Option<ReadCursor> {
+    #[cfg(feature = "tail_calls")]
+    {
+        step(cursor, end, limit, obj, table, env)
+    }
+    #[cfg(not(feature = "tail_calls"))]
+    {
+        let mut cursor = step(cursor, end, limit, obj, table, env)?;
+        while let Some((step, limit, obj, table)) = env.next.take() {
+            cursor = step(cursor, end, limit, obj, table, env)?;
+        }
+        Some(cursor)
+    }
+}
+
+#[inline(never)]
+fn skip_length_delimited<'a, 'b, 'c>(
     mut cursor: ReadCursor,
     end: NonNull<u8>,
-    stack: &mut Stack<StackEntry>,
-    arena: &mut crate::arena::Arena,
-) -> DecodeLoopResult<'a> {
+    limit: isize,
+    _obj: *mut (),
+    _table: *const Table,
+    env: &mut DecodeEnv<'a, 'b, 'c>,
+) -> Option<ReadCursor> {
     if limit > SLOP_SIZE as isize {
         cursor.read_slice(SLOP_SIZE as isize - (cursor - end));
-        return Some((cursor, limit, DecodeObject::SkipLengthDelimited));
+        return env.suspend(cursor, limit, DecodeObject::SkipLengthDelimited);
     }
     cursor.read_slice(limit - (cursor - end));
-    let stack_entry = stack.pop()?;
+    let stack_entry = env.stack.pop()?;
     if stack_entry.obj.is_null() {
         debug_assert!(stack_entry.delta_limit_or_group_tag >= 0);
-        return skip_group(
-            limit + stack_entry.delta_limit_or_group_tag,
+        continue_with!(
+            skip_group,
             cursor,
             end,
-            stack,
-            arena,
+            limit + stack_entry.delta_limit_or_group_tag,
+            core::ptr::null_mut(),
+            core::ptr::null(),
+            env
         );
     }
     let ctx = stack_entry.into_context(limit, None)?;
-    decode_loop(ctx, cursor, end, stack, arena)
+    continue_with!(
+        decode_loop,
+        cursor,
+        end,
+        ctx.limit,
+        ctx.obj as *mut Object as *mut (),
+        ctx.table,
+        env
+    )
 }
 
 #[inline(never)]
-fn skip_group<'a>(
-    limit: isize,
+fn skip_group<'a, 'b, 'c>(
     mut cursor: ReadCursor,
     end: NonNull<u8>,
-    stack: &mut Stack<StackEntry>,
-    arena: &mut crate::arena::Arena,
-) -> DecodeLoopResult<'a> {
+    limit: isize,
+    _obj: *mut (),
+    _table: *const Table,
+    env: &mut DecodeEnv<'a, 'b, 'c>,
+) -> Option<ReadCursor> {
     let limited_end = unsafe { end.offset(limit.min(0)) };
-    // loop popping the stack as needed
+    // loop popping the env.stack as needed
     loop {
         // inner parse loop
         while cursor < limited_end {
@@ -307,17 +1086,17 @@ fn skip_group<'a>(
                         if delta_limit < 0 {
                             return None;
                         }
-                        stack.push(StackEntry {
+                        env.stack.push(StackEntry {
                             obj: core::ptr::null_mut(),
                             table: core::ptr::null(),
                             delta_limit_or_group_tag: delta_limit,
                         })?;
-                        return Some((cursor, new_limit, DecodeObject::SkipLengthDelimited));
+                        return env.suspend(cursor, new_limit, DecodeObject::SkipLengthDelimited);
                     }
                 }
                 3 => {
                     // start group
-                    stack.push(StackEntry {
+                    env.stack.push(StackEntry {
                         obj: core::ptr::null_mut(),
                         table: core::ptr::null(),
                         delta_limit_or_group_tag: -(field_number as isize),
@@ -329,17 +1108,12 @@ fn skip_group<'a>(
                         obj,
                         table,
                         delta_limit_or_group_tag,
-                    } = stack.pop()?;
+                    } = env.stack.pop()?;
                     if -delta_limit_or_group_tag != field_number as isize {
                         return None;
                     }
                     if !obj.is_null() {
-                        let ctx = DecodeObjectState {
-                            limit,
-                            obj: unsafe { &mut *obj },
-                            table: unsafe { &*table },
-                        };
-                        return decode_loop(ctx, cursor, end, stack, arena);
+                        continue_with!(decode_loop, cursor, end, limit, obj as *mut (), table, env);
                     }
                 }
                 5 => {
@@ -352,17 +1126,24 @@ fn skip_group<'a>(
             }
         }
         if cursor - end == limit {
-            if stack.is_empty() {
-                return Some((cursor, limit, DecodeObject::None));
+            if env.stack.is_empty() {
+                return env.suspend(cursor, limit, DecodeObject::None);
             }
-            let stack_entry = stack.pop()?;
+            let stack_entry = env.stack.pop()?;
             if stack_entry.obj.is_null() {
                 // We are at a limit but we are finiished this group, so parse failed
                 return None;
             }
             let ctx = stack_entry.into_context(limit, None)?;
-            // TODO: this relies on tail call optimization
-            return decode_loop(ctx, cursor, end, stack, arena);
+            continue_with!(
+                decode_loop,
+                cursor,
+                end,
+                ctx.limit,
+                ctx.obj as *mut Object as *mut (),
+                ctx.table,
+                env
+            );
         }
         if cursor >= end {
             break;
@@ -371,7 +1152,7 @@ fn skip_group<'a>(
             return None;
         }
     }
-    Some((cursor, limit, DecodeObject::SkipGroup))
+    env.suspend(cursor, limit, DecodeObject::SkipGroup)
 }
 
 #[inline(always)]
@@ -384,101 +1165,312 @@ fn unpack_varint<T>(
 ) -> Option<ReadCursor> {
     while cursor < limited_end {
         let val = cursor.read_varint()?;
-        field.push(decode_fn(val), arena);
+        field.try_push(decode_fn(val), arena).ok()?;
     }
     Some(cursor)
 }
 
+// Unpacks a packed varint span that lies entirely in the buffer. The varints are counted
+// up front so the field grows at most once, after which every 16 byte block is decoded
+// straight into the reserved storage: blocks of single byte varints are widened in one
+// go, other blocks decode exactly the varints that terminate within them.
+#[inline(always)]
+fn unpack_varint_bulk<T>(
+    field: &mut RepeatedField<T>,
+    mut cursor: ReadCursor,
+    span_end: NonNull<u8>,
+    arena: &mut crate::arena::Arena,
+    decode_fn: impl Fn(u64) -> T,
+) -> Option<ReadCursor> {
+    let len = (cursor - span_end).unsigned_abs();
+    if len == 0 {
+        return Some(cursor);
+    }
+    // The last varint must terminate inside the span.
+    if cursor[len as isize - 1] >= 0x80 {
+        return None;
+    }
+    let count = unsafe { crate::wire::count_varints(cursor.0.as_ptr(), len) };
+    let old_len = field.len();
+    let mut out = field.reserve_tail(count, arena).ok()?;
+    while cursor - span_end <= -16 {
+        let mask = unsafe { crate::wire::continuation_mask(cursor.0.as_ptr()) };
+        if mask == 0 {
+            for i in 0..16 {
+                unsafe { out.add(i).write(decode_fn(cursor[i as isize] as u64)) };
+            }
+            out = unsafe { out.add(16) };
+            cursor += 16;
+            continue;
+        }
+        let n = 16 - mask.count_ones();
+        if n == 0 {
+            // No varint is longer than 10 bytes
+            return None;
+        }
+        for _ in 0..n {
+            unsafe { out.write(decode_fn(cursor.read_varint()?)) };
+            out = unsafe { out.add(1) };
+        }
+    }
+    while cursor < span_end {
+        unsafe { out.write(decode_fn(cursor.read_varint()?)) };
+        out = unsafe { out.add(1) };
+    }
+    unsafe { field.set_len(old_len + count) };
+    Some(cursor)
+}
+
 #[inline(always)]
 fn unpack_fixed<T>(
     field: &mut RepeatedField<T>,
     mut cursor: ReadCursor,
     limited_end: NonNull<u8>,
     arena: &mut crate::arena::Arena,
-) -> ReadCursor {
+) -> Option<ReadCursor> {
     while cursor < limited_end {
         let val = cursor.read_unaligned::<T>();
-        field.push(val, arena);
+        field.try_push(val, arena).ok()?;
+    }
+    Some(cursor)
+}
+
+// Element types of packed repeated fields, with the decode object that resumes them.
+trait PackedVarint: Sized + 'static {
+    fn from_varint(val: u64) -> Self;
+    fn resume(field: &mut RepeatedField<Self>) -> DecodeObject<'_>;
+}
+
+impl PackedVarint for u64 {
+    fn from_varint(val: u64) -> Self {
+        val
+    }
+    fn resume(field: &mut RepeatedField<Self>) -> DecodeObject<'_> {
+        DecodeObject::PackedU64(field)
+    }
+}
+
+impl PackedVarint for u32 {
+    fn from_varint(val: u64) -> Self {
+        val as u32
+    }
+    fn resume(field: &mut RepeatedField<Self>) -> DecodeObject<'_> {
+        DecodeObject::PackedU32(field)
+    }
+}
+
+impl PackedVarint for i64 {
+    fn from_varint(val: u64) -> Self {
+        zigzag_decode(val)
+    }
+    fn resume(field: &mut RepeatedField<Self>) -> DecodeObject<'_> {
+        DecodeObject::PackedI64Zigzag(field)
+    }
+}
+
+impl PackedVarint for i32 {
+    fn from_varint(val: u64) -> Self {
+        zigzag_decode(val as u32 as u64) as i32
+    }
+    fn resume(field: &mut RepeatedField<Self>) -> DecodeObject<'_> {
+        DecodeObject::PackedI32Zigzag(field)
+    }
+}
+
+impl PackedVarint for bool {
+    fn from_varint(val: u64) -> Self {
+        val != 0
+    }
+    fn resume(field: &mut RepeatedField<Self>) -> DecodeObject<'_> {
+        DecodeObject::PackedBool(field)
+    }
+}
+
+trait PackedFixed: Sized + 'static {
+    fn resume(field: &mut RepeatedField<Self>) -> DecodeObject<'_>;
+}
+
+impl PackedFixed for u64 {
+    fn resume(field: &mut RepeatedField<Self>) -> DecodeObject<'_> {
+        DecodeObject::PackedFixed64(field)
+    }
+}
+
+impl PackedFixed for u32 {
+    fn resume(field: &mut RepeatedField<Self>) -> DecodeObject<'_> {
+        DecodeObject::PackedFixed32(field)
     }
-    cursor
 }
 
-#[allow(clippy::too_many_arguments)]
 #[inline(never)]
-fn decode_packed<'a, T>(
-    limit: isize,
-    field: &'a mut RepeatedField<T>,
+fn decode_packed<'a, 'b, 'c, T: PackedVarint>(
     cursor: ReadCursor,
     end: NonNull<u8>,
-    stack: &mut Stack<StackEntry>,
-    arena: &mut crate::arena::Arena,
-    decode_fn: impl Fn(u64) -> T,
-    decode_obj: impl Fn(&'a mut RepeatedField<T>) -> DecodeObject<'a>,
-) -> DecodeLoopResult<'a> {
+    limit: isize,
+    field: *mut (),
+    _table: *const Table,
+    env: &mut DecodeEnv<'a, 'b, 'c>,
+) -> Option<ReadCursor> {
+    let field = unsafe { &mut *(field as *mut RepeatedField<T>) };
     if limit > 0 {
-        let cursor = unpack_varint(field, cursor, end, arena, decode_fn)?;
-        return Some((cursor, limit, decode_obj(field)));
+        let cursor = unpack_varint(field, cursor, end, env.arena, T::from_varint)?;
+        return env.suspend(cursor, limit, T::resume(field));
     }
     let limited_end = unsafe { end.offset(limit) };
-    let cursor = unpack_varint(field, cursor, limited_end, arena, decode_fn)?;
-    let ctx = stack.pop()?.into_context(limit, None)?;
-    decode_loop(ctx, cursor, end, stack, arena)
+    let cursor = unpack_varint_bulk(field, cursor, limited_end, env.arena, T::from_varint)?;
+    let ctx = env.stack.pop()?.into_context(limit, None)?;
+    continue_with!(
+        decode_loop,
+        cursor,
+        end,
+        ctx.limit,
+        ctx.obj as *mut Object as *mut (),
+        ctx.table,
+        env
+    )
 }
 
 #[inline(never)]
-fn decode_fixed<'a, T>(
-    limit: isize,
-    field: &'a mut RepeatedField<T>,
+fn decode_fixed<'a, 'b, 'c, T: PackedFixed>(
     cursor: ReadCursor,
     end: NonNull<u8>,
-    stack: &mut Stack<StackEntry>,
-    arena: &mut crate::arena::Arena,
-    decode_obj: impl Fn(&'a mut RepeatedField<T>) -> DecodeObject<'a>,
-) -> DecodeLoopResult<'a> {
+    limit: isize,
+    field: *mut (),
+    _table: *const Table,
+    env: &mut DecodeEnv<'a, 'b, 'c>,
+) -> Option<ReadCursor> {
+    let field = unsafe { &mut *(field as *mut RepeatedField<T>) };
     if limit > 0 {
-        let cursor = unpack_fixed(field, cursor, end, arena);
-        return Some((cursor, limit, decode_obj(field)));
+        let cursor = unpack_fixed(field, cursor, end, env.arena)?;
+        return env.suspend(cursor, limit, T::resume(field));
     }
     let limited_end = unsafe { end.offset(limit) };
-    let cursor = unpack_fixed(field, cursor, limited_end, arena);
-    let ctx = stack.pop()?.into_context(limit, None)?;
-    decode_loop(ctx, cursor, end, stack, arena)
+    let cursor = unpack_fixed(field, cursor, limited_end, env.arena)?;
+    let ctx = env.stack.pop()?.into_context(limit, None)?;
+    continue_with!(
+        decode_loop,
+        cursor,
+        end,
+        ctx.limit,
+        ctx.obj as *mut Object as *mut (),
+        ctx.table,
+        env
+    )
 }
 
 #[inline(never)]
-fn decode_string<'a>(
+fn decode_string<'a, 'b, 'c>(
+    mut cursor: ReadCursor,
+    end: NonNull<u8>,
     limit: isize,
-    bytes: &'a mut Bytes,
+    bytes: *mut (),
+    _table: *const Table,
+    env: &mut DecodeEnv<'a, 'b, 'c>,
+) -> Option<ReadCursor> {
+    let bytes = unsafe { &mut *(bytes as *mut Bytes) };
+    if limit > SLOP_SIZE as isize {
+        bytes
+            .try_append(
+                cursor.read_slice(SLOP_SIZE as isize - (cursor - end)),
+                env.arena,
+            )
+            .ok()?;
+        return env.suspend(cursor, limit, DecodeObject::Bytes(bytes));
+    }
+    bytes
+        .try_append(cursor.read_slice(limit - (cursor - end)), env.arena)
+        .ok()?;
+    let ctx = env.stack.pop()?.into_context(limit, None)?;
+    continue_with!(
+        decode_loop,
+        cursor,
+        end,
+        ctx.limit,
+        ctx.obj as *mut Object as *mut (),
+        ctx.table,
+        env
+    )
+}
+
+// Like decode_string, but validates each appended chunk as UTF-8. A sequence cut off at
+// the end of a chunk is validated again together with the next one.
+#[inline(never)]
+fn decode_utf8_string<'a, 'b, 'c>(
     mut cursor: ReadCursor,
     end: NonNull<u8>,
-    stack: &mut Stack<StackEntry>,
-    arena: &mut crate::arena::Arena,
-) -> DecodeLoopResult<'a> {
+    limit: isize,
+    bytes: *mut (),
+    _table: *const Table,
+    env: &mut DecodeEnv<'a, 'b, 'c>,
+) -> Option<ReadCursor> {
+    let bytes = unsafe { &mut *(bytes as *mut Bytes) };
+    let start = bytes.len() - env.utf8_pending;
     if limit > SLOP_SIZE as isize {
-        bytes.append(
-            cursor.read_slice(SLOP_SIZE as isize - (cursor - end)),
-            arena,
-        );
-        return Some((cursor, limit, DecodeObject::Bytes(bytes)));
+        bytes
+            .try_append(
+                cursor.read_slice(SLOP_SIZE as isize - (cursor - end)),
+                env.arena,
+            )
+            .ok()?;
+        let pending = validate_utf8_prefix(&bytes[start..])?;
+        return env.suspend(cursor, limit, DecodeObject::String(bytes, pending));
     }
-    bytes.append(cursor.read_slice(limit - (cursor - end)), arena);
-    let ctx = stack.pop()?.into_context(limit, None)?;
-    decode_loop(ctx, cursor, end, stack, arena)
+    bytes
+        .try_append(cursor.read_slice(limit - (cursor - end)), env.arena)
+        .ok()?;
+    if !validate_utf8(&bytes[start..]) {
+        return None;
+    }
+    let ctx = env.stack.pop()?.into_context(limit, None)?;
+    continue_with!(
+        decode_loop,
+        cursor,
+        end,
+        ctx.limit,
+        ctx.obj as *mut Object as *mut (),
+        ctx.table,
+        env
+    )
 }
 
 #[inline(never)]
-fn decode_loop<'a>(
-    mut ctx: DecodeObjectState<'a>,
+fn decode_loop<'a, 'b, 'c>(
     mut cursor: ReadCursor,
     end: NonNull<u8>,
-    stack: &mut Stack<StackEntry>,
-    arena: &mut crate::arena::Arena,
-) -> DecodeLoopResult<'a> {
+    limit: isize,
+    obj: *mut (),
+    table: *const Table,
+    env: &mut DecodeEnv<'a, 'b, 'c>,
+) -> Option<ReadCursor> {
+    let mut ctx = DecodeObjectState::<'a> {
+        limit,
+        obj: unsafe { &mut *(obj as *mut Object) },
+        table: unsafe { &*table },
+    };
     let mut limited_end = ctx.limited_end(end);
-    // loop popping the stack as needed
+    // loop popping the env.stack as needed
     loop {
         // inner parse loop
         'parse_loop: while cursor < limited_end {
+            if !TRACE_TAGS {
+                let slot = ctx.table.fast_entry(cursor.peek_tag());
+                // The fast handlers copy bytes fields, leave those to the generic path
+                let copies_bytes = env.aliasing != Aliasing::Off
+                    && matches!(
+                        slot.entry.kind(),
+                        FieldKind::Bytes
+                            | FieldKind::String
+                            | FieldKind::RepeatedBytes
+                            | FieldKind::RepeatedString
+                    );
+                if !copies_bytes {
+                    let next = (slot.handler)(ctx.obj, cursor, limited_end, slot, env.arena);
+                    if next.0 != cursor.0 {
+                        cursor = next;
+                        continue 'parse_loop;
+                    }
+                }
+            }
             let tag = cursor.read_tag()?;
             let field_number = tag >> 3;
             if TRACE_TAGS {
@@ -518,7 +1510,7 @@ fn decode_loop<'a>(
                             if tag & 7 != 0 {
                                 break 'unknown;
                             };
-                            ctx.set(entry, cursor.read_varint()? as u32);
+                            ctx.set(entry, cursor.read_varint32()?);
                         }
                         FieldKind::Varint64Zigzag => {
                             if tag & 7 != 0 {
@@ -530,10 +1522,7 @@ fn decode_loop<'a>(
                             if tag & 7 != 0 {
                                 break 'unknown;
                             };
-                            ctx.set(
-                                entry,
-                                zigzag_decode(cursor.read_varint()? as u32 as u64) as i32,
-                            );
+                            ctx.set(entry, zigzag_decode(cursor.read_varint32()? as u64) as i32);
                         }
                         FieldKind::Bool => {
                             if tag & 7 != 0 {
@@ -542,6 +1531,14 @@ fn decode_loop<'a>(
                             let val = cursor.read_varint()?;
                             ctx.set(entry, val != 0);
                         }
+                        FieldKind::BoolBit => {
+                            if tag & 7 != 0 {
+                                break 'unknown;
+                            };
+                            let val = cursor.read_varint()?;
+                            ctx.obj.set_has_bit(entry.has_bit_idx());
+                            ctx.obj.set_bit(entry.offset(), val != 0);
+                        }
                         FieldKind::Fixed64 => {
                             if tag & 7 != 1 {
                                 break 'unknown;
@@ -560,15 +1557,44 @@ fn decode_loop<'a>(
                             };
                             let len = cursor.read_size()?;
                             if cursor - limited_end + len <= SLOP_SIZE as isize {
-                                ctx.set_bytes(entry, cursor.read_slice(len), arena);
+                                let slice = cursor.read_slice(len);
+                                ctx.set_or_alias_bytes(entry, slice, env.aliasing, env.arena)?;
                             } else {
-                                ctx.push_limit(len, cursor, end, stack)?;
-                                let bytes = ctx.set_bytes(
+                                ctx.push_limit(len, cursor, end, env.stack)?;
+                                let bytes = ctx.set_or_alias_bytes(
                                     entry,
                                     cursor.read_slice(SLOP_SIZE as isize - (cursor - end)),
-                                    arena,
+                                    env.aliasing.copy(),
+                                    env.arena,
+                                )?;
+                                return env.suspend(cursor, ctx.limit, DecodeObject::Bytes(bytes));
+                            }
+                        }
+                        FieldKind::String => {
+                            if tag & 7 != 2 {
+                                break 'unknown;
+                            };
+                            let len = cursor.read_size()?;
+                            if cursor - limited_end + len <= SLOP_SIZE as isize {
+                                let slice = cursor.read_slice(len);
+                                if !validate_utf8(slice) {
+                                    return None;
+                                }
+                                ctx.set_or_alias_bytes(entry, slice, env.aliasing, env.arena)?;
+                            } else {
+                                ctx.push_limit(len, cursor, end, env.stack)?;
+                                let bytes = ctx.set_or_alias_bytes(
+                                    entry,
+                                    cursor.read_slice(SLOP_SIZE as isize - (cursor - end)),
+                                    env.aliasing.copy(),
+                                    env.arena,
+                                )?;
+                                let pending = validate_utf8_prefix(bytes)?;
+                                return env.suspend(
+                                    cursor,
+                                    ctx.limit,
+                                    DecodeObject::String(bytes, pending),
                                 );
-                                return Some((cursor, ctx.limit, DecodeObject::Bytes(bytes)));
                             }
                         }
                         FieldKind::Message => {
@@ -576,20 +1602,64 @@ fn decode_loop<'a>(
                                 break 'unknown;
                             };
                             let len = cursor.read_size()?;
-                            limited_end = ctx.push_limit(len, cursor, end, stack)?;
-                            (ctx.obj, ctx.table) = ctx.get_or_create_child_object(entry, arena);
+                            limited_end = ctx.push_limit(len, cursor, end, env.stack)?;
+                            (ctx.obj, ctx.table) =
+                                ctx.get_or_create_child_object(entry, env.arena)?;
+                        }
+                        FieldKind::InlineMessage => {
+                            if tag & 7 != 2 {
+                                break 'unknown;
+                            };
+                            let len = cursor.read_size()?;
+                            limited_end = ctx.push_limit(len, cursor, end, env.stack)?;
+                            (ctx.obj, ctx.table) = ctx.get_inline_child_object(entry);
                         }
                         FieldKind::Group => {
                             if tag & 7 != 3 {
                                 break 'unknown;
                             };
-                            ctx.push_group(field_number, stack)?;
-                            (ctx.obj, ctx.table) = ctx.get_or_create_child_object(entry, arena);
+                            ctx.push_group(field_number, env.stack)?;
+                            (ctx.obj, ctx.table) =
+                                ctx.get_or_create_child_object(entry, env.arena)?;
+                        }
+                        FieldKind::LazyMessage => {
+                            if tag & 7 != 2 {
+                                break 'unknown;
+                            };
+                            let len = cursor.read_size()?;
+                            let (lazy, child_table) =
+                                ctx.get_or_create_lazy_object(entry, len, env.arena)?;
+                            // Only the length is validated, the payload is decoded on access
+                            if let Some(bytes) = unsafe { (*lazy).bytes_mut() } {
+                                if cursor - limited_end + len <= SLOP_SIZE as isize {
+                                    let slice = cursor.read_slice(len);
+                                    append_or_alias(bytes, slice, env.aliasing, env.arena)?;
+                                } else {
+                                    ctx.push_limit(len, cursor, end, env.stack)?;
+                                    append_or_alias(
+                                        bytes,
+                                        cursor.read_slice(SLOP_SIZE as isize - (cursor - end)),
+                                        env.aliasing.copy(),
+                                        env.arena,
+                                    )?;
+                                    return env.suspend(
+                                        cursor,
+                                        ctx.limit,
+                                        DecodeObject::Bytes(bytes),
+                                    );
+                                }
+                            } else {
+                                // Already accessed, merge into the decoded object. Bytes
+                                // that failed to decode fail the merged message as well.
+                                limited_end = ctx.push_limit(len, cursor, end, env.stack)?;
+                                ctx.obj = unsafe { (*lazy).try_get_mut(child_table) }?;
+                                ctx.table = child_table;
+                            }
                         }
                         FieldKind::RepeatedVarint64 => {
                             if tag & 7 == 0 {
                                 // Unpacked
-                                ctx.add(entry, cursor.read_varint()?, arena);
+                                ctx.add(entry, cursor.read_varint()?, env.arena)?;
                             } else if tag & 7 == 2 {
                                 // Packed
                                 let len = cursor.read_size()?;
@@ -599,21 +1669,22 @@ fn decode_loop<'a>(
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<u64>>(entry.offset());
                                     let end = (cursor + len).0;
-                                    cursor = unpack_varint(field, cursor, end, arena, |v| v)?;
+                                    cursor =
+                                        unpack_varint_bulk(field, cursor, end, env.arena, |v| v)?;
                                     if cursor != end {
                                         return None;
                                     }
                                 } else {
                                     // Slow path: field spans buffers - transition to resumable parsing
-                                    ctx.push_limit(len, cursor, end, stack)?;
+                                    ctx.push_limit(len, cursor, end, env.stack)?;
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<u64>>(entry.offset());
-                                    cursor = unpack_varint(field, cursor, end, arena, |v| v)?;
-                                    return Some((
+                                    cursor = unpack_varint(field, cursor, end, env.arena, |v| v)?;
+                                    return env.suspend(
                                         cursor,
                                         ctx.limit,
                                         DecodeObject::PackedU64(field),
-                                    ));
+                                    );
                                 }
                             } else {
                                 break 'unknown;
@@ -622,7 +1693,7 @@ fn decode_loop<'a>(
                         FieldKind::RepeatedVarint32 | FieldKind::RepeatedInt32 => {
                             if tag & 7 == 0 {
                                 // Unpacked
-                                ctx.add(entry, cursor.read_varint()? as u32, arena);
+                                ctx.add(entry, cursor.read_varint32()?, env.arena)?;
                             } else if tag & 7 == 2 {
                                 // Packed
                                 let len = cursor.read_size()?;
@@ -633,22 +1704,24 @@ fn decode_loop<'a>(
                                         ctx.obj.ref_mut::<RepeatedField<u32>>(entry.offset());
                                     let end = (cursor + len).0;
                                     cursor =
-                                        unpack_varint(field, cursor, end, arena, |v| v as u32)?;
+                                        unpack_varint_bulk(field, cursor, end, env.arena, |v| {
+                                            v as u32
+                                        })?;
                                     if cursor != end {
                                         return None;
                                     }
                                 } else {
                                     // Slow path: field spans buffers - transition to resumable parsing
-                                    ctx.push_limit(len, cursor, end, stack)?;
+                                    ctx.push_limit(len, cursor, end, env.stack)?;
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<u32>>(entry.offset());
                                     cursor =
-                                        unpack_varint(field, cursor, end, arena, |v| v as u32)?;
-                                    return Some((
+                                        unpack_varint(field, cursor, end, env.arena, |v| v as u32)?;
+                                    return env.suspend(
                                         cursor,
                                         ctx.limit,
                                         DecodeObject::PackedU32(field),
-                                    ));
+                                    );
                                 }
                             } else {
                                 break 'unknown;
@@ -657,7 +1730,7 @@ fn decode_loop<'a>(
                         FieldKind::RepeatedVarint64Zigzag => {
                             if tag & 7 == 0 {
                                 // Unpacked
-                                ctx.add(entry, zigzag_decode(cursor.read_varint()?), arena);
+                                ctx.add(entry, zigzag_decode(cursor.read_varint()?), env.arena)?;
                             } else if tag & 7 == 2 {
                                 // Packed
                                 let len = cursor.read_size()?;
@@ -667,25 +1740,26 @@ fn decode_loop<'a>(
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<i64>>(entry.offset());
                                     let end = (cursor + len).0;
-                                    cursor = unpack_varint(field, cursor, end, arena, |v| {
-                                        zigzag_decode(v)
-                                    })?;
+                                    cursor =
+                                        unpack_varint_bulk(field, cursor, end, env.arena, |v| {
+                                            zigzag_decode(v)
+                                        })?;
                                     if cursor != end {
                                         return None;
                                     }
                                 } else {
                                     // Slow path: field spans buffers - transition to resumable parsing
-                                    ctx.push_limit(len, cursor, end, stack)?;
+                                    ctx.push_limit(len, cursor, end, env.stack)?;
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<i64>>(entry.offset());
-                                    cursor = unpack_varint(field, cursor, end, arena, |v| {
+                                    cursor = unpack_varint(field, cursor, end, env.arena, |v| {
                                         zigzag_decode(v)
                                     })?;
-                                    return Some((
+                                    return env.suspend(
                                         cursor,
                                         ctx.limit,
                                         DecodeObject::PackedI64Zigzag(field),
-                                    ));
+                                    );
                                 }
                             } else {
                                 break 'unknown;
@@ -696,9 +1770,9 @@ fn decode_loop<'a>(
                                 // Unpacked
                                 ctx.add(
                                     entry,
-                                    zigzag_decode(cursor.read_varint()? as u32 as u64) as i32,
-                                    arena,
-                                );
+                                    zigzag_decode(cursor.read_varint32()? as u64) as i32,
+                                    env.arena,
+                                )?;
                             } else if tag & 7 == 2 {
                                 // Packed
                                 let len = cursor.read_size()?;
@@ -708,25 +1782,26 @@ fn decode_loop<'a>(
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<i32>>(entry.offset());
                                     let end = (cursor + len).0;
-                                    cursor = unpack_varint(field, cursor, end, arena, |v| {
-                                        zigzag_decode(v as u32 as u64) as i32
-                                    })?;
+                                    cursor =
+                                        unpack_varint_bulk(field, cursor, end, env.arena, |v| {
+                                            zigzag_decode(v as u32 as u64) as i32
+                                        })?;
                                     if cursor != end {
                                         return None;
                                     }
                                 } else {
                                     // Slow path: field spans buffers - transition to resumable parsing
-                                    ctx.push_limit(len, cursor, end, stack)?;
+                                    ctx.push_limit(len, cursor, end, env.stack)?;
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<i32>>(entry.offset());
-                                    cursor = unpack_varint(field, cursor, end, arena, |v| {
+                                    cursor = unpack_varint(field, cursor, end, env.arena, |v| {
                                         zigzag_decode(v as u32 as u64) as i32
                                     })?;
-                                    return Some((
+                                    return env.suspend(
                                         cursor,
                                         ctx.limit,
                                         DecodeObject::PackedI32Zigzag(field),
-                                    ));
+                                    );
                                 }
                             } else {
                                 break 'unknown;
@@ -736,7 +1811,7 @@ fn decode_loop<'a>(
                             if tag & 7 == 0 {
                                 // Unpacked
                                 let val = cursor.read_varint()?;
-                                ctx.add(entry, val != 0, arena);
+                                ctx.add(entry, val != 0, env.arena)?;
                             } else if tag & 7 == 2 {
                                 // Packed
                                 let len = cursor.read_size()?;
@@ -746,21 +1821,25 @@ fn decode_loop<'a>(
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<bool>>(entry.offset());
                                     let end = (cursor + len).0;
-                                    cursor = unpack_varint(field, cursor, end, arena, |v| v != 0)?;
+                                    cursor =
+                                        unpack_varint_bulk(field, cursor, end, env.arena, |v| {
+                                            v != 0
+                                        })?;
                                     if cursor != end {
                                         return None;
                                     }
                                 } else {
                                     // Slow path: field spans buffers - transition to resumable parsing
-                                    ctx.push_limit(len, cursor, end, stack)?;
+                                    ctx.push_limit(len, cursor, end, env.stack)?;
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<bool>>(entry.offset());
-                                    cursor = unpack_varint(field, cursor, end, arena, |v| v != 0)?;
-                                    return Some((
+                                    cursor =
+                                        unpack_varint(field, cursor, end, env.arena, |v| v != 0)?;
+                                    return env.suspend(
                                         cursor,
                                         ctx.limit,
                                         DecodeObject::PackedBool(field),
-                                    ));
+                                    );
                                 }
                             } else {
                                 break 'unknown;
@@ -769,7 +1848,7 @@ fn decode_loop<'a>(
                         FieldKind::RepeatedFixed64 => {
                             if tag & 7 == 1 {
                                 // Unpacked
-                                ctx.add(entry, cursor.read_unaligned::<u64>(), arena);
+                                ctx.add(entry, cursor.read_unaligned::<u64>(), env.arena)?;
                             } else if tag & 7 == 2 {
                                 // Packed
                                 let len = cursor.read_size()?;
@@ -779,21 +1858,21 @@ fn decode_loop<'a>(
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<u64>>(entry.offset());
                                     let end = (cursor + len).0;
-                                    cursor = unpack_fixed(field, cursor, end, arena);
+                                    cursor = unpack_fixed(field, cursor, end, env.arena)?;
                                     if cursor != end {
                                         return None;
                                     }
                                 } else {
                                     // Slow path: field spans buffers - transition to resumable parsing
-                                    ctx.push_limit(len, cursor, end, stack)?;
+                                    ctx.push_limit(len, cursor, end, env.stack)?;
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<u64>>(entry.offset());
-                                    cursor = unpack_fixed(field, cursor, end, arena);
-                                    return Some((
+                                    cursor = unpack_fixed(field, cursor, end, env.arena)?;
+                                    return env.suspend(
                                         cursor,
                                         ctx.limit,
                                         DecodeObject::PackedFixed64(field),
-                                    ));
+                                    );
                                 }
                             } else {
                                 break 'unknown;
@@ -802,7 +1881,7 @@ fn decode_loop<'a>(
                         FieldKind::RepeatedFixed32 => {
                             if tag & 7 == 5 {
                                 // Unpacked
-                                ctx.add(entry, cursor.read_unaligned::<u32>(), arena);
+                                ctx.add(entry, cursor.read_unaligned::<u32>(), env.arena)?;
                             } else if tag & 7 == 2 {
                                 // Packed
                                 let len = cursor.read_size()?;
@@ -812,21 +1891,21 @@ fn decode_loop<'a>(
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<u32>>(entry.offset());
                                     let end = (cursor + len).0;
-                                    cursor = unpack_fixed(field, cursor, end, arena);
+                                    cursor = unpack_fixed(field, cursor, end, env.arena)?;
                                     if cursor != end {
                                         return None;
                                     }
                                 } else {
                                     // Slow path: field spans buffers - transition to resumable parsing
-                                    ctx.push_limit(len, cursor, end, stack)?;
+                                    ctx.push_limit(len, cursor, end, env.stack)?;
                                     let field =
                                         ctx.obj.ref_mut::<RepeatedField<u32>>(entry.offset());
-                                    cursor = unpack_fixed(field, cursor, end, arena);
-                                    return Some((
+                                    cursor = unpack_fixed(field, cursor, end, env.arena)?;
+                                    return env.suspend(
                                         cursor,
                                         ctx.limit,
                                         DecodeObject::PackedFixed32(field),
-                                    ));
+                                    );
                                 }
                             } else {
                                 break 'unknown;
@@ -838,15 +1917,42 @@ fn decode_loop<'a>(
                             };
                             let len = cursor.read_size()?;
                             if cursor - limited_end + len <= SLOP_SIZE as isize {
-                                ctx.add_bytes(entry, cursor.read_slice(len), arena);
+                                let slice = cursor.read_slice(len);
+                                ctx.add_or_alias_bytes(entry, slice, env.aliasing, env.arena)?;
+                            } else {
+                                ctx.push_limit(len, cursor, end, env.stack)?;
+                                let bytes = ctx.add_bytes(
+                                    entry,
+                                    cursor.read_slice(SLOP_SIZE as isize - (cursor - end)),
+                                    env.arena,
+                                )?;
+                                return env.suspend(cursor, ctx.limit, DecodeObject::Bytes(bytes));
+                            }
+                        }
+                        FieldKind::RepeatedString => {
+                            if tag & 7 != 2 {
+                                break 'unknown;
+                            };
+                            let len = cursor.read_size()?;
+                            if cursor - limited_end + len <= SLOP_SIZE as isize {
+                                let slice = cursor.read_slice(len);
+                                if !validate_utf8(slice) {
+                                    return None;
+                                }
+                                ctx.add_or_alias_bytes(entry, slice, env.aliasing, env.arena)?;
                             } else {
-                                ctx.push_limit(len, cursor, end, stack)?;
+                                ctx.push_limit(len, cursor, end, env.stack)?;
                                 let bytes = ctx.add_bytes(
                                     entry,
                                     cursor.read_slice(SLOP_SIZE as isize - (cursor - end)),
-                                    arena,
+                                    env.arena,
+                                )?;
+                                let pending = validate_utf8_prefix(bytes)?;
+                                return env.suspend(
+                                    cursor,
+                                    ctx.limit,
+                                    DecodeObject::String(bytes, pending),
                                 );
-                                return Some((cursor, ctx.limit, DecodeObject::Bytes(bytes)));
                             }
                         }
                         FieldKind::RepeatedMessage => {
@@ -854,15 +1960,23 @@ fn decode_loop<'a>(
                                 break 'unknown;
                             };
                             let len = cursor.read_size()?;
-                            limited_end = ctx.push_limit(len, cursor, end, stack)?;
-                            (ctx.obj, ctx.table) = ctx.add_child_object(entry, arena);
+                            limited_end = ctx.push_limit(len, cursor, end, env.stack)?;
+                            (ctx.obj, ctx.table) = ctx.add_child_object(entry, env.arena)?;
+                        }
+                        FieldKind::RepeatedInlineMessage => {
+                            if tag & 7 != 2 {
+                                break 'unknown;
+                            };
+                            let len = cursor.read_size()?;
+                            limited_end = ctx.push_limit(len, cursor, end, env.stack)?;
+                            (ctx.obj, ctx.table) = ctx.add_inline_child_object(entry, env.arena)?;
                         }
                         FieldKind::RepeatedGroup => {
                             if tag & 7 != 3 {
                                 break 'unknown;
                             };
-                            ctx.push_group(field_number, stack)?;
-                            (ctx.obj, ctx.table) = ctx.add_child_object(entry, arena);
+                            ctx.push_group(field_number, env.stack)?;
+                            (ctx.obj, ctx.table) = ctx.add_child_object(entry, env.arena)?;
                         }
                         FieldKind::Unknown => {
                             break 'unknown;
@@ -874,9 +1988,9 @@ fn decode_loop<'a>(
             // unknown field
             if field_number == 0 {
                 if tag == 0 {
-                    // 0 byte can used to terminate parsing, but only if stack is empty
-                    if stack.is_empty() {
-                        return Some((cursor, ctx.limit, DecodeObject::None));
+                    // 0 byte can used to terminate parsing, but only if env.stack is empty
+                    if env.stack.is_empty() {
+                        return env.suspend(cursor, ctx.limit, DecodeObject::None);
                     }
                     return None;
                 }
@@ -898,19 +2012,27 @@ fn decode_loop<'a>(
                     if cursor - limited_end + len <= SLOP_SIZE as isize {
                         cursor.read_slice(len);
                     } else {
-                        ctx.push_limit(len, cursor, end, stack)?;
-                        return Some((cursor, ctx.limit, DecodeObject::SkipLengthDelimited));
+                        ctx.push_limit(len, cursor, end, env.stack)?;
+                        return env.suspend(cursor, ctx.limit, DecodeObject::SkipLengthDelimited);
                     }
                 }
                 3 => {
                     // start group
-                    // push to stack until end group
-                    ctx.push_group(field_number, stack)?;
-                    return skip_group(ctx.limit, cursor, end, stack, arena);
+                    // push to env.stack until end group
+                    ctx.push_group(field_number, env.stack)?;
+                    continue_with!(
+                        skip_group,
+                        cursor,
+                        end,
+                        ctx.limit,
+                        core::ptr::null_mut(),
+                        core::ptr::null(),
+                        env
+                    );
                 }
                 4 => {
                     // end group
-                    ctx.pop_group(field_number, stack)?;
+                    ctx.pop_group(field_number, env.stack)?;
                 }
                 5 => {
                     // fixed32
@@ -922,10 +2044,10 @@ fn decode_loop<'a>(
             }
         }
         if cursor - end == ctx.limit {
-            if stack.is_empty() {
-                return Some((cursor, ctx.limit, DecodeObject::None));
+            if env.stack.is_empty() {
+                return env.suspend(cursor, ctx.limit, DecodeObject::None);
             }
-            limited_end = ctx.pop_limit(end, stack)?;
+            limited_end = ctx.pop_limit(end, env.stack)?;
             continue;
         }
         if cursor >= end {
@@ -935,7 +2057,7 @@ fn decode_loop<'a>(
             return None;
         }
     }
-    Some((cursor, ctx.limit, DecodeObject::Message(ctx.obj, ctx.table)))
+    env.suspend(cursor, ctx.limit, DecodeObject::Message(ctx.obj, ctx.table))
 }
 
 struct ResumeableState<'a> {
@@ -950,6 +2072,7 @@ impl<'a> ResumeableState<'a> {
         buf: &[u8],
         stack: &mut Stack<StackEntry>,
         arena: &mut crate::arena::Arena,
+        aliasing: Aliasing,
     ) -> Option<Self> {
         let len = buf.len() as isize;
         self.limit -= len;
@@ -959,86 +2082,77 @@ impl<'a> ResumeableState<'a> {
         }
         let (mut cursor, end) = ReadCursor::new(buf);
         cursor += self.overrun;
-        let (new_cursor, new_limit, new_object) = match self.object {
+        let null = core::ptr::null_mut::<()>();
+        let mut utf8_pending = 0;
+        let (step, obj, table): (DecodeStep, *mut (), *const Table) = match self.object {
             DecodeObject::Message(obj, table) => {
-                let ctx = DecodeObjectState {
-                    limit: self.limit,
-                    obj,
-                    table,
-                };
-                decode_loop(ctx, cursor, end, stack, arena)?
-            }
-            DecodeObject::Bytes(bytes) => {
-                decode_string(self.limit, bytes, cursor, end, stack, arena)?
-            }
-            DecodeObject::SkipLengthDelimited => {
-                skip_length_delimited(self.limit, cursor, end, stack, arena)?
+                (decode_loop, obj as *mut Object as *mut (), table)
             }
-            DecodeObject::SkipGroup => skip_group(self.limit, cursor, end, stack, arena)?,
-            DecodeObject::PackedU64(field) => decode_packed(
-                self.limit,
-                field,
-                cursor,
-                end,
-                stack,
-                arena,
-                |v| v,
-                DecodeObject::PackedU64,
-            )?,
-            DecodeObject::PackedU32(field) => decode_packed(
-                self.limit,
-                field,
-                cursor,
-                end,
-                stack,
-                arena,
-                |v| v as u32,
-                DecodeObject::PackedU32,
-            )?,
-            DecodeObject::PackedI64Zigzag(field) => decode_packed(
-                self.limit,
-                field,
-                cursor,
-                end,
-                stack,
-                arena,
-                zigzag_decode,
-                DecodeObject::PackedI64Zigzag,
-            )?,
-            DecodeObject::PackedI32Zigzag(field) => decode_packed(
-                self.limit,
-                field,
-                cursor,
-                end,
-                stack,
-                arena,
-                |v| zigzag_decode(v as u32 as u64) as i32,
-                DecodeObject::PackedI32Zigzag,
-            )?,
-            DecodeObject::PackedBool(field) => decode_packed(
-                self.limit,
-                field,
-                cursor,
-                end,
-                stack,
-                arena,
-                |v| v != 0,
-                DecodeObject::PackedBool,
-            )?,
-            DecodeObject::PackedFixed64(field) => {
-                decode_fixed(self.limit, field, cursor, end, stack, arena, |f| {
-                    DecodeObject::PackedFixed64(f)
-                })?
-            }
-            DecodeObject::PackedFixed32(field) => {
-                decode_fixed(self.limit, field, cursor, end, stack, arena, |f| {
-                    DecodeObject::PackedFixed32(f)
-                })?
+            DecodeObject::Bytes(bytes) => (
+                decode_string,
+                bytes as *mut Bytes as *mut (),
+                core::ptr::null(),
+            ),
+            DecodeObject::String(bytes, pending) => {
+                utf8_pending = pending;
+                (
+                    decode_utf8_string,
+                    bytes as *mut Bytes as *mut (),
+                    core::ptr::null(),
+                )
             }
+            DecodeObject::SkipLengthDelimited => (skip_length_delimited, null, core::ptr::null()),
+            DecodeObject::SkipGroup => (skip_group, null, core::ptr::null()),
+            DecodeObject::PackedU64(field) => (
+                decode_packed::<u64>,
+                field as *mut RepeatedField<u64> as *mut (),
+                core::ptr::null(),
+            ),
+            DecodeObject::PackedU32(field) => (
+                decode_packed::<u32>,
+                field as *mut RepeatedField<u32> as *mut (),
+                core::ptr::null(),
+            ),
+            DecodeObject::PackedI64Zigzag(field) => (
+                decode_packed::<i64>,
+                field as *mut RepeatedField<i64> as *mut (),
+                core::ptr::null(),
+            ),
+            DecodeObject::PackedI32Zigzag(field) => (
+                decode_packed::<i32>,
+                field as *mut RepeatedField<i32> as *mut (),
+                core::ptr::null(),
+            ),
+            DecodeObject::PackedBool(field) => (
+                decode_packed::<bool>,
+                field as *mut RepeatedField<bool> as *mut (),
+                core::ptr::null(),
+            ),
+            DecodeObject::PackedFixed64(field) => (
+                decode_fixed::<u64>,
+                field as *mut RepeatedField<u64> as *mut (),
+                core::ptr::null(),
+            ),
+            DecodeObject::PackedFixed32(field) => (
+                decode_fixed::<u32>,
+                field as *mut RepeatedField<u32> as *mut (),
+                core::ptr::null(),
+            ),
             DecodeObject::None => unreachable!(),
         };
-        self.limit = new_limit;
-        self.object = new_object;
+        let mut env = DecodeEnv {
+            stack,
+            arena,
+            aliasing,
+            utf8_pending,
+            limit: self.limit,
+            object: DecodeObject::None,
+            #[cfg(not(feature = "tail_calls"))]
+            next: None,
+        };
+        let new_cursor = run_steps(step, cursor, end, self.limit, obj, table, &mut env)?;
+        self.limit = env.limit;
+        self.object = env.object;
         self.overrun = new_cursor - end;
         Some(self)
     }
@@ -1049,6 +2163,7 @@ pub struct ResumeableDecode<'a, const STACK_DEPTH: usize> {
     state: MaybeUninit<ResumeableState<'a>>,
     patch_buffer: [u8; SLOP_SIZE * 2],
     stack: StackWithStorage<StackEntry, STACK_DEPTH>,
+    aliasing: bool,
 }
 
 impl<'a, const STACK_DEPTH: usize> ResumeableDecode<'a, STACK_DEPTH> {
@@ -1063,6 +2178,7 @@ impl<'a, const STACK_DEPTH: usize> ResumeableDecode<'a, STACK_DEPTH> {
             }),
             patch_buffer: [0; SLOP_SIZE * 2],
             stack: Default::default(),
+            aliasing: false,
         }
     }
 
@@ -1084,6 +2200,31 @@ impl<'a, const STACK_DEPTH: usize> ResumeableDecode<'a, STACK_DEPTH> {
             }),
             patch_buffer: [0; SLOP_SIZE * 2],
             stack: Default::default(),
+            aliasing: false,
+        }
+    }
+
+    /// Like `new`, but bytes and string fields that lie entirely within one buffer point
+    /// into that buffer instead of being copied into the arena. Fields that straddle two
+    /// buffers are still copied.
+    ///
+    /// # Safety
+    /// Every buffer passed to `resume` must outlive the decoded message, and the message
+    /// must not be modified in place.
+    pub unsafe fn new_aliased<'pool: 'a, T: ProtobufMut<'pool> + ?Sized>(
+        obj: &'a mut T,
+        limit: isize,
+    ) -> Self {
+        let mut decoder = Self::new(obj, limit);
+        decoder.aliasing = true;
+        decoder
+    }
+
+    fn aliasing(&self, input: bool) -> Aliasing {
+        match (self.aliasing, input) {
+            (false, _) => Aliasing::Off,
+            (true, false) => Aliasing::Copy,
+            (true, true) => Aliasing::Input,
         }
     }
 
@@ -1094,16 +2235,19 @@ impl<'a, const STACK_DEPTH: usize> ResumeableDecode<'a, STACK_DEPTH> {
 
     #[must_use]
     pub fn finish(self, arena: &mut crate::arena::Arena) -> bool {
+        let aliasing = self.aliasing(false);
         let ResumeableDecode {
             state,
             patch_buffer,
             mut stack,
+            ..
         } = self;
         let state = unsafe { state.assume_init() };
         if matches!(state.object, DecodeObject::None) {
             return false;
         }
-        let Some(state) = state.go_decode(&patch_buffer[..SLOP_SIZE], &mut stack, arena) else {
+        let Some(state) = state.go_decode(&patch_buffer[..SLOP_SIZE], &mut stack, arena, aliasing)
+        else {
             return false;
         };
 
@@ -1114,6 +2258,7 @@ impl<'a, const STACK_DEPTH: usize> ResumeableDecode<'a, STACK_DEPTH> {
 
     fn resume_impl(&mut self, buf: &[u8], arena: &mut crate::arena::Arena) -> Option<()> {
         let size = buf.len();
+        let (patch_aliasing, input_aliasing) = (self.aliasing(false), self.aliasing(true));
         let mut state = unsafe { self.state.assume_init_read() };
         if matches!(state.object, DecodeObject::None) {
             // Already finished
@@ -1121,17 +2266,32 @@ impl<'a, const STACK_DEPTH: usize> ResumeableDecode<'a, STACK_DEPTH> {
         }
         if buf.len() > SLOP_SIZE {
             self.patch_buffer[SLOP_SIZE..].copy_from_slice(&buf[..SLOP_SIZE]);
-            state = state.go_decode(&self.patch_buffer[..SLOP_SIZE], &mut self.stack, arena)?;
+            state = state.go_decode(
+                &self.patch_buffer[..SLOP_SIZE],
+                &mut self.stack,
+                arena,
+                patch_aliasing,
+            )?;
             if matches!(state.object, DecodeObject::None) {
                 // TODO: Alter the state to indicate that we've ended on a 0 tag
                 // Ended on 0 tag
                 return None;
             }
-            state = state.go_decode(&buf[..size - SLOP_SIZE], &mut self.stack, arena)?;
+            state = state.go_decode(
+                &buf[..size - SLOP_SIZE],
+                &mut self.stack,
+                arena,
+                input_aliasing,
+            )?;
             self.patch_buffer[..SLOP_SIZE].copy_from_slice(&buf[size - SLOP_SIZE..]);
         } else {
             self.patch_buffer[SLOP_SIZE..SLOP_SIZE + size].copy_from_slice(buf);
-            state = state.go_decode(&self.patch_buffer[..size], &mut self.stack, arena)?;
+            state = state.go_decode(
+                &self.patch_buffer[..size],
+                &mut self.stack,
+                arena,
+                patch_aliasing,
+            )?;
             self.patch_buffer.copy_within(size..size + SLOP_SIZE, 0);
         }
         self.state.write(state);
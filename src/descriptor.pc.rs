@@ -164,6 +164,40 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -815,6 +849,96 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        10u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        18u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, package),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        26u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::RepeatedBytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, dependency),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        80u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::RepeatedInt32,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, public_dependency),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        88u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::RepeatedInt32,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, weak_dependency),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        98u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            2u32,
+                            core::mem::offset_of!(ProtoType, syntax),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        112u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            3u32,
+                            core::mem::offset_of!(ProtoType, edition),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        122u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::RepeatedBytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, option_dependency),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -1165,6 +1289,54 @@ pub mod google {
                         size: core::mem::size_of::<ProtoType>() as u16,
                         descriptor: ProtoType::descriptor_proto(),
                     },
+                    fast_entries: [
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            8u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, start),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            16u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                1u32,
+                                core::mem::offset_of!(ProtoType, end),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                    ],
                     decode_entries: [
                         protocrap::decoding::TableEntry(0),
                         protocrap::decoding::TableEntry::new(
@@ -1323,6 +1495,54 @@ pub mod google {
                         size: core::mem::size_of::<ProtoType>() as u16,
                         descriptor: ProtoType::descriptor_proto(),
                     },
+                    fast_entries: [
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            8u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, start),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            16u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                1u32,
+                                core::mem::offset_of!(ProtoType, end),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                    ],
                     decode_entries: [
                         protocrap::decoding::TableEntry(0),
                         protocrap::decoding::TableEntry::new(
@@ -1922,6 +2142,61 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        10u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        82u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::RepeatedBytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, reserved_name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        88u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, visibility),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -2352,6 +2627,75 @@ pub mod google {
                         size: core::mem::size_of::<ProtoType>() as u16,
                         descriptor: ProtoType::descriptor_proto(),
                     },
+                    fast_entries: [
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            8u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, number),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            18u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bytes,
+                                1u32,
+                                core::mem::offset_of!(ProtoType, full_name),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            26u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bytes,
+                                2u32,
+                                core::mem::offset_of!(ProtoType, r#type),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            40u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bool,
+                                3u32,
+                                core::mem::offset_of!(ProtoType, reserved),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            48u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bool,
+                                4u32,
+                                core::mem::offset_of!(ProtoType, repeated),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                    ],
                     decode_entries: [
                         protocrap::decoding::TableEntry(0),
                         protocrap::decoding::TableEntry::new(
@@ -2660,6 +3004,47 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        24u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, verification),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry(0),
@@ -4324,6 +4709,110 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        10u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        18u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            5u32,
+                            core::mem::offset_of!(ProtoType, extendee),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        24u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, number),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        32u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            2u32,
+                            core::mem::offset_of!(ProtoType, label),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        40u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            3u32,
+                            core::mem::offset_of!(ProtoType, r#type),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        50u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            4u32,
+                            core::mem::offset_of!(ProtoType, type_name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        58u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            6u32,
+                            core::mem::offset_of!(ProtoType, default_value),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        72u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            7u32,
+                            core::mem::offset_of!(ProtoType, oneof_index),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        82u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            8u32,
+                            core::mem::offset_of!(ProtoType, json_name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        136u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            9u32,
+                            core::mem::offset_of!(ProtoType, proto3_optional),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -4552,6 +5041,47 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        10u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -4709,6 +5239,54 @@ pub mod google {
                         size: core::mem::size_of::<ProtoType>() as u16,
                         descriptor: ProtoType::descriptor_proto(),
                     },
+                    fast_entries: [
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            8u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, start),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            16u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                1u32,
+                                core::mem::offset_of!(ProtoType, end),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                    ],
                     decode_entries: [
                         protocrap::decoding::TableEntry(0),
                         protocrap::decoding::TableEntry::new(
@@ -5040,6 +5618,61 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        10u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        42u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::RepeatedBytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, reserved_name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        48u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, visibility),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -5304,6 +5937,54 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        10u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        16u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, number),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -5543,6 +6224,47 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        10u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -5926,6 +6648,75 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        10u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, name),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        18u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, input_type),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        26u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            2u32,
+                            core::mem::offset_of!(ProtoType, output_type),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        40u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            3u32,
+                            core::mem::offset_of!(ProtoType, client_streaming),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        48u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            4u32,
+                            core::mem::offset_of!(ProtoType, server_streaming),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -7025,6 +7816,161 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        10u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, java_package),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        66u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, java_outer_classname),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        72u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            5u32,
+                            core::mem::offset_of!(ProtoType, optimize_for),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        80u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            2u32,
+                            core::mem::offset_of!(ProtoType, java_multiple_files),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        90u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            6u32,
+                            core::mem::offset_of!(ProtoType, go_package),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        128u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            7u32,
+                            core::mem::offset_of!(ProtoType, cc_generic_services),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        136u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            8u32,
+                            core::mem::offset_of!(ProtoType, java_generic_services),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        144u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            9u32,
+                            core::mem::offset_of!(ProtoType, py_generic_services),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        160u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            3u32,
+                            core::mem::offset_of!(
+                                ProtoType, java_generate_equals_and_hash
+                            ),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        298u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            13u32,
+                            core::mem::offset_of!(ProtoType, csharp_namespace),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        184u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            10u32,
+                            core::mem::offset_of!(ProtoType, deprecated),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        322u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            15u32,
+                            core::mem::offset_of!(ProtoType, php_class_prefix),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        330u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            16u32,
+                            core::mem::offset_of!(ProtoType, php_namespace),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        216u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            4u32,
+                            core::mem::offset_of!(ProtoType, java_string_check_utf8),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        354u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            17u32,
+                            core::mem::offset_of!(ProtoType, php_metadata_namespace),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        362u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            18u32,
+                            core::mem::offset_of!(ProtoType, ruby_package),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        248u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            11u32,
+                            core::mem::offset_of!(ProtoType, cc_enable_arenas),
+                        ),
+                    ),
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -8513,12 +9459,85 @@ pub mod google {
                         encoded_tag: 7994u32,
                     },
                 ],
-                table: protocrap::tables::Table {
-                    num_encode_entries: 7usize as u16,
-                    num_decode_entries: 1000usize as u16,
-                    size: core::mem::size_of::<ProtoType>() as u16,
-                    descriptor: ProtoType::descriptor_proto(),
-                },
+                table: protocrap::tables::Table {
+                    num_encode_entries: 7usize as u16,
+                    num_decode_entries: 1000usize as u16,
+                    size: core::mem::size_of::<ProtoType>() as u16,
+                    descriptor: ProtoType::descriptor_proto(),
+                },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        8u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, message_set_wire_format),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        16u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            1u32,
+                            core::mem::offset_of!(
+                                ProtoType, no_standard_descriptor_accessor
+                            ),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        24u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            2u32,
+                            core::mem::offset_of!(ProtoType, deprecated),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        56u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            3u32,
+                            core::mem::offset_of!(ProtoType, map_entry),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        88u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            4u32,
+                            core::mem::offset_of!(
+                                ProtoType, deprecated_legacy_json_field_conflicts
+                            ),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -9723,6 +10742,54 @@ pub mod google {
                         size: core::mem::size_of::<ProtoType>() as u16,
                         descriptor: ProtoType::descriptor_proto(),
                     },
+                    fast_entries: [
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            18u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bytes,
+                                1u32,
+                                core::mem::offset_of!(ProtoType, value),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            24u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, edition),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                    ],
                     decode_entries: [
                         protocrap::decoding::TableEntry(0),
                         protocrap::decoding::TableEntry(0),
@@ -10019,6 +11086,75 @@ pub mod google {
                         size: core::mem::size_of::<ProtoType>() as u16,
                         descriptor: ProtoType::descriptor_proto(),
                     },
+                    fast_entries: [
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            8u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, edition_introduced),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            16u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                1u32,
+                                core::mem::offset_of!(ProtoType, edition_deprecated),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            26u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bytes,
+                                2u32,
+                                core::mem::offset_of!(ProtoType, deprecation_warning),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            32u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                3u32,
+                                core::mem::offset_of!(ProtoType, edition_removed),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            42u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bytes,
+                                4u32,
+                                core::mem::offset_of!(ProtoType, removal_error),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                    ],
                     decode_entries: [
                         protocrap::decoding::TableEntry(0),
                         protocrap::decoding::TableEntry::new(
@@ -10771,6 +11907,110 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        8u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, ctype),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        16u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, packed),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        24u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            5u32,
+                            core::mem::offset_of!(ProtoType, deprecated),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        40u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            3u32,
+                            core::mem::offset_of!(ProtoType, lazy),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        48u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            2u32,
+                            core::mem::offset_of!(ProtoType, jstype),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        80u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            6u32,
+                            core::mem::offset_of!(ProtoType, weak),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        120u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            4u32,
+                            core::mem::offset_of!(ProtoType, unverified_lazy),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        128u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            7u32,
+                            core::mem::offset_of!(ProtoType, debug_redact),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        136u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            8u32,
+                            core::mem::offset_of!(ProtoType, retention),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        152u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::RepeatedInt32,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, targets),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -12052,6 +13292,40 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -13375,6 +14649,63 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        16u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, allow_alias),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        24u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, deprecated),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        48u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            2u32,
+                            core::mem::offset_of!(
+                                ProtoType, deprecated_legacy_json_field_conflicts
+                            ),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry(0),
@@ -14722,6 +16053,54 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        8u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, deprecated),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        24u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, debug_redact),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -15987,6 +17366,47 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        264u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, deprecated),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry(0),
@@ -17296,6 +18716,54 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        264u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bool,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, deprecated),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        272u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, idempotency_level),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry(0),
@@ -18494,6 +19962,54 @@ pub mod google {
                         size: core::mem::size_of::<ProtoType>() as u16,
                         descriptor: ProtoType::descriptor_proto(),
                     },
+                    fast_entries: [
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            10u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bytes,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, name_part),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            16u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bool,
+                                1u32,
+                                core::mem::offset_of!(ProtoType, is_extension),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                    ],
                     decode_entries: [
                         protocrap::decoding::TableEntry(0),
                         protocrap::decoding::TableEntry::new(
@@ -18865,6 +20381,82 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        26u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, identifier_value),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        32u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Varint64,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, positive_int_value),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        40u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Varint64,
+                            2u32,
+                            core::mem::offset_of!(ProtoType, negative_int_value),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        49u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Fixed64,
+                            3u32,
+                            core::mem::offset_of!(ProtoType, double_value),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        58u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            4u32,
+                            core::mem::offset_of!(ProtoType, string_value),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        66u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Bytes,
+                            5u32,
+                            core::mem::offset_of!(ProtoType, aggregate_value),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry(0),
@@ -19003,6 +20595,40 @@ pub mod google {
                         size: core::mem::size_of::<ProtoType>() as u16,
                         descriptor: ProtoType::descriptor_proto(),
                     },
+                    fast_entries: [
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                    ],
                     decode_entries: [protocrap::decoding::TableEntry(0)],
                     aux_entries: [],
                 };
@@ -19553,6 +21179,96 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        8u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, field_presence),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        16u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, enum_type),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        24u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            2u32,
+                            core::mem::offset_of!(ProtoType, repeated_field_encoding),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        32u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            3u32,
+                            core::mem::offset_of!(ProtoType, utf8_validation),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        40u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            4u32,
+                            core::mem::offset_of!(ProtoType, message_encoding),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        48u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            5u32,
+                            core::mem::offset_of!(ProtoType, json_format),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        56u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            6u32,
+                            core::mem::offset_of!(ProtoType, enforce_naming_style),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        64u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            7u32,
+                            core::mem::offset_of!(ProtoType, default_symbol_visibility),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -19816,6 +21532,47 @@ pub mod google {
                         size: core::mem::size_of::<ProtoType>() as u16,
                         descriptor: ProtoType::descriptor_proto(),
                     },
+                    fast_entries: [
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            24u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, edition),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                    ],
                     decode_entries: [
                         protocrap::decoding::TableEntry(0),
                         protocrap::decoding::TableEntry(0),
@@ -20051,6 +21808,54 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::new(
+                        32u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            0u32,
+                            core::mem::offset_of!(ProtoType, minimum_edition),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::new(
+                        40u32,
+                        protocrap::decoding::TableEntry::new(
+                            protocrap::wire::FieldKind::Int32,
+                            1u32,
+                            core::mem::offset_of!(ProtoType, maximum_edition),
+                        ),
+                    ),
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -20307,6 +22112,77 @@ pub mod google {
                         size: core::mem::size_of::<ProtoType>() as u16,
                         descriptor: ProtoType::descriptor_proto(),
                     },
+                    fast_entries: [
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            10u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::RepeatedInt32,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, path),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            18u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::RepeatedInt32,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, span),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            26u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bytes,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, leading_comments),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            34u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bytes,
+                                1u32,
+                                core::mem::offset_of!(ProtoType, trailing_comments),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            50u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::RepeatedBytes,
+                                0u32,
+                                core::mem::offset_of!(
+                                    ProtoType, leading_detached_comments
+                                ),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                    ],
                     decode_entries: [
                         protocrap::decoding::TableEntry(0),
                         protocrap::decoding::TableEntry::new(
@@ -20436,6 +22312,40 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
@@ -20724,6 +22634,75 @@ pub mod google {
                         size: core::mem::size_of::<ProtoType>() as u16,
                         descriptor: ProtoType::descriptor_proto(),
                     },
+                    fast_entries: [
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::new(
+                            10u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::RepeatedInt32,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, path),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            18u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Bytes,
+                                0u32,
+                                core::mem::offset_of!(ProtoType, source_file),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            24u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                1u32,
+                                core::mem::offset_of!(ProtoType, begin),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            32u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                2u32,
+                                core::mem::offset_of!(ProtoType, end),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::new(
+                            40u32,
+                            protocrap::decoding::TableEntry::new(
+                                protocrap::wire::FieldKind::Int32,
+                                3u32,
+                                core::mem::offset_of!(ProtoType, semantic),
+                            ),
+                        ),
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                        protocrap::decoding::FastEntry::EMPTY,
+                    ],
                     decode_entries: [
                         protocrap::decoding::TableEntry(0),
                         protocrap::decoding::TableEntry::new(
@@ -20854,6 +22833,40 @@ pub mod google {
                     size: core::mem::size_of::<ProtoType>() as u16,
                     descriptor: ProtoType::descriptor_proto(),
                 },
+                fast_entries: [
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                    protocrap::decoding::FastEntry::EMPTY,
+                ],
                 decode_entries: [
                     protocrap::decoding::TableEntry(0),
                     protocrap::decoding::TableEntry::new(
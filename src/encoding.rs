@@ -2,11 +2,12 @@ use core::{mem::MaybeUninit, ptr::NonNull};
 
 use crate::{
     ProtobufRef,
-    base::Object,
-    containers::Bytes,
+    arena::Arena,
+    base::{LazyContents, LazyMessage, Object, RepeatedObjects},
+    containers::{Bytes, RepeatedField},
     tables::{AuxTableEntry, Table},
     utils::{Stack, StackWithStorage},
-    wire::{FieldKind, SLOP_SIZE, WriteCursor, zigzag_encode},
+    wire::{FieldKind, ForwardWriteCursor, SLOP_SIZE, WriteCursor, zigzag_encode},
 };
 
 #[repr(C)]
@@ -35,6 +36,7 @@ impl StackEntry {
                 table: unsafe { &*self.table },
                 field_idx: self.field_idx,
                 rep_field_idx: self.rep_field_idx,
+                packed_byte_count: 0,
             },
             self.tag,
             self.byte_count,
@@ -53,6 +55,8 @@ struct ObjectEncodeState<'a> {
     table: &'a [TableEntry],
     field_idx: usize,
     rep_field_idx: usize,
+    // Byte count at the end of the packed field being written, which may span buffers.
+    packed_byte_count: isize,
 }
 
 impl<'a> ObjectEncodeState<'a> {
@@ -63,6 +67,7 @@ impl<'a> ObjectEncodeState<'a> {
             table: table_entries,
             field_idx: table_entries.len(),
             rep_field_idx: 0,
+            packed_byte_count: 0,
         }
     }
 
@@ -159,16 +164,17 @@ fn write_repeated_packed<T>(
     obj_state: &mut ObjectEncodeState,
     cursor: &mut WriteCursor,
     begin: NonNull<u8>,
+    byte_count: isize,
     tag: u32,
     slice: &[T],
     write: impl Fn(&mut WriteCursor, &T),
 ) {
     if obj_state.rep_field_idx == 0 {
         obj_state.rep_field_idx = slice.len();
+        obj_state.packed_byte_count = count(*cursor, begin, byte_count);
     }
 
     // Write all values backwards without tags
-    let start_ptr = cursor.0;
     while obj_state.rep_field_idx > 0 {
         if *cursor <= begin {
             break;
@@ -179,8 +185,8 @@ fn write_repeated_packed<T>(
 
     // Only write tag + length if we wrote all values
     if obj_state.rep_field_idx == 0 && !slice.is_empty() {
-        let packed_len = unsafe { start_ptr.as_ptr().offset_from(cursor.0.as_ptr()) as u64 };
-        cursor.write_varint(packed_len);
+        let packed_len = count(*cursor, begin, byte_count) - obj_state.packed_byte_count;
+        cursor.write_varint(packed_len as u64);
         cursor.write_tag(tag); // Tag already has wire type 2
     }
 }
@@ -311,6 +317,15 @@ fn encode_loop<'a>(
                     cursor.write_tag(tag);
                 }
             }
+            FieldKind::BoolBit => {
+                if obj_state.has_bit(has_bit) {
+                    if cursor <= begin {
+                        break;
+                    }
+                    cursor.write_varint(obj_state.obj.bit(offset as u32) as u64);
+                    cursor.write_tag(tag);
+                }
+            }
             FieldKind::Fixed64 => {
                 if obj_state.has_bit(has_bit) {
                     if cursor <= begin {
@@ -329,7 +344,7 @@ fn encode_loop<'a>(
                     cursor.write_tag(tag);
                 }
             }
-            FieldKind::Bytes => {
+            FieldKind::Bytes | FieldKind::String => {
                 if obj_state.has_bit(has_bit) {
                     if cursor <= begin {
                         break;
@@ -363,6 +378,19 @@ fn encode_loop<'a>(
                     continue 'out; // Continue with child message
                 }
             }
+            FieldKind::InlineMessage => {
+                if obj_state.has_bit(has_bit) {
+                    let AuxTableEntry {
+                        offset,
+                        child_table,
+                    } = Table::table(obj_state.table).aux_entry(offset);
+                    let child = obj_state.obj.ref_at::<Object>(offset as usize);
+                    obj_state.field_idx -= 1;
+                    obj_state.push(tag, count(cursor, begin, byte_count), stack)?;
+                    obj_state = ObjectEncodeState::new(child, unsafe { &*child_table });
+                    continue 'out; // Continue with child message
+                }
+            }
             FieldKind::Group => {
                 let AuxTableEntry {
                     offset,
@@ -384,6 +412,42 @@ fn encode_loop<'a>(
                     continue 'out; // Continue with child group
                 }
             }
+            FieldKind::LazyMessage => {
+                let AuxTableEntry {
+                    offset,
+                    child_table,
+                } = Table::table(obj_state.table).aux_entry(offset);
+                let lazy = obj_state.get::<LazyMessage>(offset as usize);
+                if !lazy.0.is_null() {
+                    match unsafe { (*lazy.0).contents() } {
+                        LazyContents::Encoded(bytes) => {
+                            if cursor <= begin {
+                                break;
+                            }
+                            let len = bytes.len();
+                            let buffer_size = (cursor - begin) as usize;
+                            if buffer_size < len {
+                                obj_state.field_idx -= 1;
+                                obj_state.push(tag, count(cursor, begin, byte_count), stack)?;
+                                cursor.write_slice(&bytes[len - buffer_size..]);
+                                return Some((
+                                    cursor,
+                                    EncodeObject::String(&bytes[..len - buffer_size]),
+                                ));
+                            }
+                            cursor.write_slice(bytes);
+                            cursor.write_varint(bytes.len() as u64);
+                            cursor.write_tag(tag);
+                        }
+                        LazyContents::Object(child) => {
+                            obj_state.field_idx -= 1;
+                            obj_state.push(tag, count(cursor, begin, byte_count), stack)?;
+                            obj_state = ObjectEncodeState::new(child, unsafe { &*child_table });
+                            continue 'out; // Continue with child message
+                        }
+                    }
+                }
+            }
             FieldKind::RepeatedVarint64 => {
                 let slice = obj_state.get_slice::<u64>(offset);
                 if tag & 7 == 2 {
@@ -391,6 +455,7 @@ fn encode_loop<'a>(
                         &mut obj_state,
                         &mut cursor,
                         begin,
+                        byte_count,
                         tag,
                         slice,
                         |cursor, &val| {
@@ -417,6 +482,7 @@ fn encode_loop<'a>(
                         &mut obj_state,
                         &mut cursor,
                         begin,
+                        byte_count,
                         tag,
                         slice,
                         |cursor, &val| {
@@ -443,6 +509,7 @@ fn encode_loop<'a>(
                         &mut obj_state,
                         &mut cursor,
                         begin,
+                        byte_count,
                         tag,
                         slice,
                         |cursor, &val| {
@@ -469,6 +536,7 @@ fn encode_loop<'a>(
                         &mut obj_state,
                         &mut cursor,
                         begin,
+                        byte_count,
                         tag,
                         slice,
                         |cursor, &val| {
@@ -495,6 +563,7 @@ fn encode_loop<'a>(
                         &mut obj_state,
                         &mut cursor,
                         begin,
+                        byte_count,
                         tag,
                         slice,
                         |cursor, &val| {
@@ -521,6 +590,7 @@ fn encode_loop<'a>(
                         &mut obj_state,
                         &mut cursor,
                         begin,
+                        byte_count,
                         tag,
                         slice,
                         |cursor, &val| {
@@ -547,6 +617,7 @@ fn encode_loop<'a>(
                         &mut obj_state,
                         &mut cursor,
                         begin,
+                        byte_count,
                         tag,
                         slice,
                         |cursor, &val| {
@@ -573,6 +644,7 @@ fn encode_loop<'a>(
                         &mut obj_state,
                         &mut cursor,
                         begin,
+                        byte_count,
                         tag,
                         slice,
                         |cursor, &val| {
@@ -592,7 +664,7 @@ fn encode_loop<'a>(
                     );
                 }
             }
-            FieldKind::RepeatedBytes => {
+            FieldKind::RepeatedBytes | FieldKind::RepeatedString => {
                 let slice = obj_state.get_slice::<Bytes>(offset);
                 if obj_state.rep_field_idx == 0 {
                     obj_state.rep_field_idx = slice.len();
@@ -607,8 +679,11 @@ fn encode_loop<'a>(
                     // We don't use slop as we need to write length prefix and tag too.
                     let buffer_size = (cursor - begin) as usize;
                     if buffer_size < len {
-                        cursor.write_slice(&bytes[len - buffer_size..]);
+                        if obj_state.rep_field_idx == 0 {
+                            obj_state.field_idx -= 1;
+                        }
                         obj_state.push(tag, count(cursor, begin, byte_count), stack)?;
+                        cursor.write_slice(&bytes[len - buffer_size..]);
                         return Some((cursor, EncodeObject::String(&bytes[..len - buffer_size])));
                     }
                     cursor.write_slice(bytes);
@@ -616,14 +691,15 @@ fn encode_loop<'a>(
                     cursor.write_tag(tag);
                 }
             }
-            FieldKind::RepeatedMessage => {
+            FieldKind::RepeatedMessage | FieldKind::RepeatedInlineMessage => {
                 let AuxTableEntry {
                     offset,
                     child_table,
                 } = Table::table(obj_state.table).aux_entry(offset);
-                let slice = obj_state.get_slice::<*const Object>(offset as usize);
+                let child_table = unsafe { &*child_table };
+                let elements = RepeatedObjects::new(obj_state.obj, kind, offset, child_table);
                 if obj_state.rep_field_idx == 0 {
-                    obj_state.rep_field_idx = slice.len();
+                    obj_state.rep_field_idx = elements.len();
                 }
                 if obj_state.rep_field_idx > 0 {
                     obj_state.rep_field_idx -= 1;
@@ -631,10 +707,8 @@ fn encode_loop<'a>(
                         obj_state.field_idx -= 1;
                     }
                     obj_state.push(tag, count(cursor, begin, byte_count), stack)?;
-                    obj_state = ObjectEncodeState::new(
-                        unsafe { &*slice[obj_state.rep_field_idx] },
-                        unsafe { &*child_table },
-                    );
+                    obj_state =
+                        ObjectEncodeState::new(elements.get(obj_state.rep_field_idx), child_table);
                     continue 'out; // Continue with child message
                 }
             }
@@ -667,11 +741,243 @@ fn encode_loop<'a>(
                 }
             }
         }
+        if obj_state.rep_field_idx != 0 {
+            // Repeated field interrupted by the end of the buffer
+            break;
+        }
         obj_state.field_idx -= 1;
     }
     Some((cursor, EncodeObject::Object(obj_state)))
 }
 
+fn varint_len(val: u64) -> usize {
+    crate::wire::varint_size(val) as usize
+}
+
+// Receives the lengths of the length delimited fields (submessages and packed fields) in
+// the order the forward encoder writes their length prefixes.
+trait SizeSink {
+    fn reserve(&mut self) -> usize;
+    fn record(&mut self, slot: usize, len: usize);
+}
+
+impl SizeSink for () {
+    fn reserve(&mut self) -> usize {
+        0
+    }
+    fn record(&mut self, _slot: usize, _len: usize) {}
+}
+
+struct SizeCache<'s, 'b, 'c> {
+    sizes: &'s mut RepeatedField<usize>,
+    arena: &'b mut Arena<'c>,
+}
+
+impl SizeSink for SizeCache<'_, '_, '_> {
+    fn reserve(&mut self) -> usize {
+        self.sizes.push(0, self.arena);
+        self.sizes.len() - 1
+    }
+    fn record(&mut self, slot: usize, len: usize) {
+        self.sizes[slot] = len;
+    }
+}
+
+fn repeated_len<T>(
+    tag: u32,
+    slice: &[T],
+    sizes: &mut impl SizeSink,
+    len: impl Fn(&T) -> usize,
+) -> usize {
+    if slice.is_empty() {
+        return 0;
+    }
+    let payload: usize = slice.iter().map(len).sum();
+    if tag & 7 == 2 {
+        let slot = sizes.reserve();
+        sizes.record(slot, payload);
+        varint_len(tag as u64) + varint_len(payload as u64) + payload
+    } else {
+        slice.len() * varint_len(tag as u64) + payload
+    }
+}
+
+// Computes the exact number of bytes encode_loop will produce for the object, walking the
+// same encode entries and has bits. Returns None if messages nest deeper than max_depth.
+pub(crate) fn encoded_len(obj: &Object, table: &Table, max_depth: usize) -> Option<usize> {
+    sized_len(obj, table, max_depth, &mut ())
+}
+
+fn sized_len(
+    obj: &Object,
+    table: &Table,
+    max_depth: usize,
+    sizes: &mut impl SizeSink,
+) -> Option<usize> {
+    let mut len = 0;
+    for &TableEntry {
+        has_bit,
+        kind,
+        offset,
+        encoded_tag: tag,
+    } in table.encode_entries()
+    {
+        let offset = offset as usize;
+        let tag_len = varint_len(tag as u64);
+        len += match kind {
+            FieldKind::Unknown => unreachable!(),
+            FieldKind::Varint64 if obj.has_bit(has_bit) => {
+                tag_len + varint_len(obj.get::<u64>(offset))
+            }
+            FieldKind::Varint32 if obj.has_bit(has_bit) => {
+                tag_len + varint_len(obj.get::<u32>(offset) as u64)
+            }
+            FieldKind::Int32 if obj.has_bit(has_bit) => {
+                tag_len + varint_len(obj.get::<i32>(offset) as i64 as u64)
+            }
+            FieldKind::Varint64Zigzag if obj.has_bit(has_bit) => {
+                tag_len + varint_len(zigzag_encode(obj.get::<i64>(offset)))
+            }
+            FieldKind::Varint32Zigzag if obj.has_bit(has_bit) => {
+                tag_len + varint_len(zigzag_encode(obj.get::<i32>(offset) as i64) as u32 as u64)
+            }
+            FieldKind::Bool | FieldKind::BoolBit if obj.has_bit(has_bit) => tag_len + 1,
+            FieldKind::Fixed64 if obj.has_bit(has_bit) => tag_len + 8,
+            FieldKind::Fixed32 if obj.has_bit(has_bit) => tag_len + 4,
+            FieldKind::Bytes | FieldKind::String if obj.has_bit(has_bit) => {
+                let bytes_len = obj.bytes(offset).len();
+                tag_len + varint_len(bytes_len as u64) + bytes_len
+            }
+            FieldKind::Message | FieldKind::Group | FieldKind::InlineMessage => {
+                let AuxTableEntry {
+                    offset,
+                    child_table,
+                } = table.aux_entry(offset);
+                let child_ptr = if kind != FieldKind::InlineMessage {
+                    obj.get::<*const Object>(offset as usize)
+                } else if obj.has_bit(has_bit) {
+                    obj.ref_at::<Object>(offset as usize)
+                } else {
+                    core::ptr::null()
+                };
+                if child_ptr.is_null() {
+                    0
+                } else {
+                    let child_len = |sizes: &mut _| {
+                        sized_len(
+                            unsafe { &*child_ptr },
+                            unsafe { &*child_table },
+                            max_depth.checked_sub(1)?,
+                            sizes,
+                        )
+                    };
+                    if kind == FieldKind::Group {
+                        // Start and end group tags only differ in the wire type bits.
+                        2 * tag_len + child_len(sizes)?
+                    } else {
+                        let slot = sizes.reserve();
+                        let child_len = child_len(sizes)?;
+                        sizes.record(slot, child_len);
+                        tag_len + varint_len(child_len as u64) + child_len
+                    }
+                }
+            }
+            FieldKind::LazyMessage => {
+                let AuxTableEntry {
+                    offset,
+                    child_table,
+                } = table.aux_entry(offset);
+                let lazy = obj.get::<LazyMessage>(offset as usize);
+                let child_len = if lazy.0.is_null() {
+                    None
+                } else {
+                    match unsafe { (*lazy.0).contents() } {
+                        LazyContents::Encoded(bytes) => Some(bytes.len()),
+                        LazyContents::Object(child) => {
+                            let slot = sizes.reserve();
+                            let child_len = sized_len(
+                                child,
+                                unsafe { &*child_table },
+                                max_depth.checked_sub(1)?,
+                                sizes,
+                            )?;
+                            sizes.record(slot, child_len);
+                            Some(child_len)
+                        }
+                    }
+                };
+                child_len.map_or(0, |len| tag_len + varint_len(len as u64) + len)
+            }
+            FieldKind::RepeatedVarint64 => {
+                repeated_len(tag, obj.get_slice::<u64>(offset), sizes, |&val| {
+                    varint_len(val)
+                })
+            }
+            FieldKind::RepeatedVarint32 => {
+                repeated_len(tag, obj.get_slice::<u32>(offset), sizes, |&val| {
+                    varint_len(val as u64)
+                })
+            }
+            FieldKind::RepeatedInt32 => {
+                repeated_len(tag, obj.get_slice::<i32>(offset), sizes, |&val| {
+                    varint_len(val as i64 as u64)
+                })
+            }
+            FieldKind::RepeatedVarint64Zigzag => {
+                repeated_len(tag, obj.get_slice::<i64>(offset), sizes, |&val| {
+                    varint_len(zigzag_encode(val))
+                })
+            }
+            FieldKind::RepeatedVarint32Zigzag => {
+                repeated_len(tag, obj.get_slice::<i32>(offset), sizes, |&val| {
+                    varint_len(zigzag_encode(val as i64) as u32 as u64)
+                })
+            }
+            FieldKind::RepeatedBool => {
+                repeated_len(tag, obj.get_slice::<bool>(offset), sizes, |_| 1)
+            }
+            FieldKind::RepeatedFixed64 => {
+                repeated_len(tag, obj.get_slice::<u64>(offset), sizes, |_| 8)
+            }
+            FieldKind::RepeatedFixed32 => {
+                repeated_len(tag, obj.get_slice::<u32>(offset), sizes, |_| 4)
+            }
+            FieldKind::RepeatedBytes | FieldKind::RepeatedString => obj
+                .get_slice::<Bytes>(offset)
+                .iter()
+                .map(|bytes| tag_len + varint_len(bytes.len() as u64) + bytes.len())
+                .sum(),
+            FieldKind::RepeatedMessage
+            | FieldKind::RepeatedGroup
+            | FieldKind::RepeatedInlineMessage => {
+                let AuxTableEntry {
+                    offset,
+                    child_table,
+                } = table.aux_entry(offset);
+                let child_table = unsafe { &*child_table };
+                let elements = RepeatedObjects::new(obj, kind, offset, child_table);
+                let mut field_len = 0;
+                for i in 0..elements.len() {
+                    let child = elements.get(i);
+                    field_len += if kind == FieldKind::RepeatedGroup {
+                        2 * tag_len
+                            + sized_len(child, child_table, max_depth.checked_sub(1)?, sizes)?
+                    } else {
+                        let slot = sizes.reserve();
+                        let child_len =
+                            sized_len(child, child_table, max_depth.checked_sub(1)?, sizes)?;
+                        sizes.record(slot, child_len);
+                        tag_len + varint_len(child_len as u64) + child_len
+                    };
+                }
+                field_len
+            }
+            _ => 0,
+        };
+    }
+    Some(len)
+}
+
 struct ResumableState<'a> {
     object: EncodeObject<'a>,
     overrun: isize,
@@ -773,3 +1079,599 @@ impl<'a, const STACK_DEPTH: usize> ResumeableEncode<'a, STACK_DEPTH> {
         Some(ResumeResult::NeedsMoreBuffer)
     }
 }
+
+// Forward encoding. The sizing pass records every length prefix in a size cache in the
+// arena, after which the message is written front to back, so chunks can be sent as soon as
+// they are full.
+
+#[derive(Clone, Copy)]
+struct ForwardEncodeState<'a> {
+    obj: &'a Object,
+    table: &'a [TableEntry],
+    field_idx: usize,
+    rep_field_idx: usize,
+}
+
+impl<'a> ForwardEncodeState<'a> {
+    fn new(obj: &'a Object, table: &'a Table) -> Self {
+        Self {
+            obj,
+            table: table.encode_entries(),
+            field_idx: 0,
+            rep_field_idx: 0,
+        }
+    }
+
+    fn next_element(&mut self, len: usize) {
+        self.rep_field_idx += 1;
+        if self.rep_field_idx == len {
+            self.rep_field_idx = 0;
+            self.field_idx += 1;
+        }
+    }
+}
+
+struct ForwardStackEntry<'a> {
+    state: ForwardEncodeState<'a>,
+    end_group_tag: u32,
+}
+
+enum ForwardEncodeObject<'a> {
+    Done,
+    Object(ForwardEncodeState<'a>),
+    Bytes(&'a [u8], ForwardEncodeState<'a>),
+}
+
+struct SizeCursor<'a> {
+    sizes: &'a [usize],
+    idx: usize,
+}
+
+impl SizeCursor<'_> {
+    fn next(&mut self) -> u64 {
+        let size = self.sizes[self.idx];
+        self.idx += 1;
+        size as u64
+    }
+}
+
+// Copies as much of bytes as fits before limit and returns the rest.
+fn write_bytes_forward<'a>(
+    cursor: &mut ForwardWriteCursor,
+    limit: NonNull<u8>,
+    bytes: &'a [u8],
+) -> &'a [u8] {
+    let n = bytes
+        .len()
+        .min((limit.as_ptr() as isize - cursor.0.as_ptr() as isize).max(0) as usize);
+    cursor.write_slice(&bytes[..n]);
+    &bytes[n..]
+}
+
+// Returns false if the buffer ran out before all elements were written.
+fn write_repeated_forward<T>(
+    obj_state: &mut ForwardEncodeState,
+    cursor: &mut ForwardWriteCursor,
+    limit: NonNull<u8>,
+    tag: u32,
+    slice: &[T],
+    write: impl Fn(&mut ForwardWriteCursor, &T),
+) -> bool {
+    while obj_state.rep_field_idx < slice.len() {
+        if *cursor >= limit {
+            return false;
+        }
+        cursor.write_tag(tag);
+        write(cursor, &slice[obj_state.rep_field_idx]);
+        obj_state.rep_field_idx += 1;
+    }
+    obj_state.rep_field_idx = 0;
+    true
+}
+
+// Packed fields count rep_field_idx from 1 once the tag and length are written.
+fn write_packed_forward<T>(
+    obj_state: &mut ForwardEncodeState,
+    cursor: &mut ForwardWriteCursor,
+    limit: NonNull<u8>,
+    tag: u32,
+    slice: &[T],
+    sizes: &mut SizeCursor,
+    write: impl Fn(&mut ForwardWriteCursor, &T),
+) -> bool {
+    if slice.is_empty() {
+        return true;
+    }
+    if obj_state.rep_field_idx == 0 {
+        cursor.write_tag(tag);
+        cursor.write_varint(sizes.next());
+        obj_state.rep_field_idx = 1;
+    }
+    while obj_state.rep_field_idx <= slice.len() {
+        if *cursor >= limit {
+            return false;
+        }
+        write(cursor, &slice[obj_state.rep_field_idx - 1]);
+        obj_state.rep_field_idx += 1;
+    }
+    obj_state.rep_field_idx = 0;
+    true
+}
+
+// Writes fields while the cursor is before limit. A single field may write up to
+// SLOP_SIZE - 1 bytes past limit, except for bytes payloads which stop at limit.
+fn encode_forward<'a>(
+    object: ForwardEncodeObject<'a>,
+    mut cursor: ForwardWriteCursor,
+    limit: NonNull<u8>,
+    sizes: &mut SizeCursor,
+    stack: &mut Stack<ForwardStackEntry<'a>>,
+) -> Option<(ForwardWriteCursor, ForwardEncodeObject<'a>)> {
+    let mut obj_state = match object {
+        ForwardEncodeObject::Done => return Some((cursor, ForwardEncodeObject::Done)),
+        ForwardEncodeObject::Object(obj_state) => obj_state,
+        ForwardEncodeObject::Bytes(bytes, obj_state) => {
+            let rest = write_bytes_forward(&mut cursor, limit, bytes);
+            if !rest.is_empty() {
+                return Some((cursor, ForwardEncodeObject::Bytes(rest, obj_state)));
+            }
+            obj_state
+        }
+    };
+    loop {
+        if obj_state.field_idx == obj_state.table.len() {
+            if stack.is_empty() {
+                return Some((cursor, ForwardEncodeObject::Done));
+            }
+            if cursor >= limit {
+                break;
+            }
+            let ForwardStackEntry {
+                state,
+                end_group_tag,
+            } = stack.pop()?;
+            if end_group_tag != 0 {
+                cursor.write_tag(end_group_tag);
+            }
+            obj_state = state;
+            continue;
+        }
+        if cursor >= limit {
+            break;
+        }
+        let TableEntry {
+            has_bit,
+            kind,
+            offset,
+            encoded_tag: tag,
+        } = obj_state.table[obj_state.field_idx];
+        let offset = offset as usize;
+        let has_bit = obj_state.obj.has_bit(has_bit);
+        let obj = obj_state.obj;
+        match kind {
+            FieldKind::Unknown => {
+                unreachable!()
+            }
+            FieldKind::Varint64 if has_bit => {
+                cursor.write_tag(tag);
+                cursor.write_varint(obj.get::<u64>(offset));
+            }
+            FieldKind::Varint32 if has_bit => {
+                cursor.write_tag(tag);
+                cursor.write_varint(obj.get::<u32>(offset) as u64);
+            }
+            FieldKind::Int32 if has_bit => {
+                cursor.write_tag(tag);
+                cursor.write_varint(obj.get::<i32>(offset) as i64 as u64);
+            }
+            FieldKind::Varint64Zigzag if has_bit => {
+                cursor.write_tag(tag);
+                cursor.write_varint(zigzag_encode(obj.get::<i64>(offset)));
+            }
+            FieldKind::Varint32Zigzag if has_bit => {
+                cursor.write_tag(tag);
+                cursor.write_varint(zigzag_encode(obj.get::<i32>(offset) as i64) as u32 as u64);
+            }
+            FieldKind::Bool if has_bit => {
+                cursor.write_tag(tag);
+                cursor.write_varint(obj.get::<bool>(offset) as u64);
+            }
+            FieldKind::BoolBit if has_bit => {
+                cursor.write_tag(tag);
+                cursor.write_varint(obj.bit(offset as u32) as u64);
+            }
+            FieldKind::Fixed64 if has_bit => {
+                cursor.write_tag(tag);
+                cursor.write_unaligned(obj.get::<u64>(offset));
+            }
+            FieldKind::Fixed32 if has_bit => {
+                cursor.write_tag(tag);
+                cursor.write_unaligned(obj.get::<u32>(offset));
+            }
+            FieldKind::Bytes | FieldKind::String if has_bit => {
+                let bytes = obj.bytes(offset);
+                cursor.write_tag(tag);
+                cursor.write_varint(bytes.len() as u64);
+                obj_state.field_idx += 1;
+                let rest = write_bytes_forward(&mut cursor, limit, bytes);
+                if !rest.is_empty() {
+                    return Some((cursor, ForwardEncodeObject::Bytes(rest, obj_state)));
+                }
+                continue;
+            }
+            FieldKind::Message | FieldKind::Group | FieldKind::InlineMessage => {
+                let AuxTableEntry {
+                    offset,
+                    child_table,
+                } = Table::table(obj_state.table).aux_entry(offset);
+                let child_ptr = if kind != FieldKind::InlineMessage {
+                    obj.get::<*const Object>(offset as usize)
+                } else if has_bit {
+                    obj.ref_at::<Object>(offset as usize)
+                } else {
+                    core::ptr::null()
+                };
+                if !child_ptr.is_null() {
+                    cursor.write_tag(tag);
+                    let end_group_tag = if kind == FieldKind::Group {
+                        tag + 1 // END_GROUP wire type
+                    } else {
+                        cursor.write_varint(sizes.next());
+                        0
+                    };
+                    obj_state.field_idx += 1;
+                    stack.push(ForwardStackEntry {
+                        state: obj_state,
+                        end_group_tag,
+                    })?;
+                    obj_state =
+                        ForwardEncodeState::new(unsafe { &*child_ptr }, unsafe { &*child_table });
+                    continue;
+                }
+            }
+            FieldKind::LazyMessage => {
+                let AuxTableEntry {
+                    offset,
+                    child_table,
+                } = Table::table(obj_state.table).aux_entry(offset);
+                let lazy = obj.get::<LazyMessage>(offset as usize);
+                if !lazy.0.is_null() {
+                    cursor.write_tag(tag);
+                    obj_state.field_idx += 1;
+                    match unsafe { (*lazy.0).contents() } {
+                        LazyContents::Encoded(bytes) => {
+                            cursor.write_varint(bytes.len() as u64);
+                            let rest = write_bytes_forward(&mut cursor, limit, bytes);
+                            if !rest.is_empty() {
+                                return Some((cursor, ForwardEncodeObject::Bytes(rest, obj_state)));
+                            }
+                        }
+                        LazyContents::Object(child) => {
+                            cursor.write_varint(sizes.next());
+                            stack.push(ForwardStackEntry {
+                                state: obj_state,
+                                end_group_tag: 0,
+                            })?;
+                            obj_state = ForwardEncodeState::new(child, unsafe { &*child_table });
+                        }
+                    }
+                    continue;
+                }
+            }
+            FieldKind::RepeatedVarint64 => {
+                let slice = obj.get_slice::<u64>(offset);
+                let write = |cursor: &mut ForwardWriteCursor, &val: &u64| cursor.write_varint(val);
+                let done = if tag & 7 == 2 {
+                    write_packed_forward(
+                        &mut obj_state,
+                        &mut cursor,
+                        limit,
+                        tag,
+                        slice,
+                        sizes,
+                        write,
+                    )
+                } else {
+                    write_repeated_forward(&mut obj_state, &mut cursor, limit, tag, slice, write)
+                };
+                if !done {
+                    break;
+                }
+            }
+            FieldKind::RepeatedVarint32 => {
+                let slice = obj.get_slice::<u32>(offset);
+                let write =
+                    |cursor: &mut ForwardWriteCursor, &val: &u32| cursor.write_varint(val as u64);
+                let done = if tag & 7 == 2 {
+                    write_packed_forward(
+                        &mut obj_state,
+                        &mut cursor,
+                        limit,
+                        tag,
+                        slice,
+                        sizes,
+                        write,
+                    )
+                } else {
+                    write_repeated_forward(&mut obj_state, &mut cursor, limit, tag, slice, write)
+                };
+                if !done {
+                    break;
+                }
+            }
+            FieldKind::RepeatedInt32 => {
+                let slice = obj.get_slice::<i32>(offset);
+                let write = |cursor: &mut ForwardWriteCursor, &val: &i32| {
+                    cursor.write_varint(val as i64 as u64)
+                };
+                let done = if tag & 7 == 2 {
+                    write_packed_forward(
+                        &mut obj_state,
+                        &mut cursor,
+                        limit,
+                        tag,
+                        slice,
+                        sizes,
+                        write,
+                    )
+                } else {
+                    write_repeated_forward(&mut obj_state, &mut cursor, limit, tag, slice, write)
+                };
+                if !done {
+                    break;
+                }
+            }
+            FieldKind::RepeatedVarint64Zigzag => {
+                let slice = obj.get_slice::<i64>(offset);
+                let write = |cursor: &mut ForwardWriteCursor, &val: &i64| {
+                    cursor.write_varint(zigzag_encode(val))
+                };
+                let done = if tag & 7 == 2 {
+                    write_packed_forward(
+                        &mut obj_state,
+                        &mut cursor,
+                        limit,
+                        tag,
+                        slice,
+                        sizes,
+                        write,
+                    )
+                } else {
+                    write_repeated_forward(&mut obj_state, &mut cursor, limit, tag, slice, write)
+                };
+                if !done {
+                    break;
+                }
+            }
+            FieldKind::RepeatedVarint32Zigzag => {
+                let slice = obj.get_slice::<i32>(offset);
+                let write = |cursor: &mut ForwardWriteCursor, &val: &i32| {
+                    cursor.write_varint(zigzag_encode(val as i64) as u32 as u64)
+                };
+                let done = if tag & 7 == 2 {
+                    write_packed_forward(
+                        &mut obj_state,
+                        &mut cursor,
+                        limit,
+                        tag,
+                        slice,
+                        sizes,
+                        write,
+                    )
+                } else {
+                    write_repeated_forward(&mut obj_state, &mut cursor, limit, tag, slice, write)
+                };
+                if !done {
+                    break;
+                }
+            }
+            FieldKind::RepeatedBool => {
+                let slice = obj.get_slice::<bool>(offset);
+                let write =
+                    |cursor: &mut ForwardWriteCursor, &val: &bool| cursor.write_varint(val as u64);
+                let done = if tag & 7 == 2 {
+                    write_packed_forward(
+                        &mut obj_state,
+                        &mut cursor,
+                        limit,
+                        tag,
+                        slice,
+                        sizes,
+                        write,
+                    )
+                } else {
+                    write_repeated_forward(&mut obj_state, &mut cursor, limit, tag, slice, write)
+                };
+                if !done {
+                    break;
+                }
+            }
+            FieldKind::RepeatedFixed64 => {
+                let slice = obj.get_slice::<u64>(offset);
+                let write =
+                    |cursor: &mut ForwardWriteCursor, &val: &u64| cursor.write_unaligned(val);
+                let done = if tag & 7 == 2 {
+                    write_packed_forward(
+                        &mut obj_state,
+                        &mut cursor,
+                        limit,
+                        tag,
+                        slice,
+                        sizes,
+                        write,
+                    )
+                } else {
+                    write_repeated_forward(&mut obj_state, &mut cursor, limit, tag, slice, write)
+                };
+                if !done {
+                    break;
+                }
+            }
+            FieldKind::RepeatedFixed32 => {
+                let slice = obj.get_slice::<u32>(offset);
+                let write =
+                    |cursor: &mut ForwardWriteCursor, &val: &u32| cursor.write_unaligned(val);
+                let done = if tag & 7 == 2 {
+                    write_packed_forward(
+                        &mut obj_state,
+                        &mut cursor,
+                        limit,
+                        tag,
+                        slice,
+                        sizes,
+                        write,
+                    )
+                } else {
+                    write_repeated_forward(&mut obj_state, &mut cursor, limit, tag, slice, write)
+                };
+                if !done {
+                    break;
+                }
+            }
+            FieldKind::RepeatedBytes | FieldKind::RepeatedString => {
+                let slice = obj.get_slice::<Bytes>(offset);
+                if obj_state.rep_field_idx < slice.len() {
+                    let bytes: &[u8] = &slice[obj_state.rep_field_idx];
+                    cursor.write_tag(tag);
+                    cursor.write_varint(bytes.len() as u64);
+                    obj_state.next_element(slice.len());
+                    let rest = write_bytes_forward(&mut cursor, limit, bytes);
+                    if !rest.is_empty() {
+                        return Some((cursor, ForwardEncodeObject::Bytes(rest, obj_state)));
+                    }
+                    continue;
+                }
+            }
+            FieldKind::RepeatedMessage
+            | FieldKind::RepeatedGroup
+            | FieldKind::RepeatedInlineMessage => {
+                let AuxTableEntry {
+                    offset,
+                    child_table,
+                } = Table::table(obj_state.table).aux_entry(offset);
+                let child_table = unsafe { &*child_table };
+                let elements = RepeatedObjects::new(obj, kind, offset, child_table);
+                if obj_state.rep_field_idx < elements.len() {
+                    let child = elements.get(obj_state.rep_field_idx);
+                    cursor.write_tag(tag);
+                    let end_group_tag = if kind == FieldKind::RepeatedGroup {
+                        tag + 1 // END_GROUP wire type
+                    } else {
+                        cursor.write_varint(sizes.next());
+                        0
+                    };
+                    obj_state.next_element(elements.len());
+                    stack.push(ForwardStackEntry {
+                        state: obj_state,
+                        end_group_tag,
+                    })?;
+                    obj_state = ForwardEncodeState::new(child, child_table);
+                    continue;
+                }
+            }
+            _ => {}
+        }
+        obj_state.field_idx += 1;
+    }
+    Some((cursor, ForwardEncodeObject::Object(obj_state)))
+}
+
+pub enum ForwardResult {
+    /// Encoding finished; the final chunk holds this many bytes.
+    Done(usize),
+    /// The whole chunk was filled and more output follows.
+    Full,
+}
+
+/// Encodes a message front to back into caller supplied chunks. Every chunk but the last
+/// is filled completely, so it can be sent before the rest of the message is encoded.
+pub struct ForwardEncode<'a, const STACK_DEPTH: usize> {
+    object: ForwardEncodeObject<'a>,
+    sizes: RepeatedField<usize>,
+    size_idx: usize,
+    encoded_len: usize,
+    // Bytes written past the end of the previous chunk.
+    pending: [u8; SLOP_SIZE],
+    pending_len: usize,
+    stack: StackWithStorage<ForwardStackEntry<'a>, STACK_DEPTH>,
+}
+
+impl<'a, const STACK_DEPTH: usize> ForwardEncode<'a, STACK_DEPTH> {
+    /// Computes the sizes of all length delimited fields into a size cache allocated in
+    /// arena. Returns None if messages nest deeper than STACK_DEPTH.
+    pub fn new<'pool: 'a, T: ProtobufRef<'pool> + ?Sized>(
+        obj: &'a T,
+        arena: &mut Arena,
+    ) -> Option<Self> {
+        let table = obj.table();
+        let mut sizes = RepeatedField::new();
+        let encoded_len = sized_len(
+            obj.as_object(),
+            table,
+            STACK_DEPTH,
+            &mut SizeCache {
+                sizes: &mut sizes,
+                arena,
+            },
+        )?;
+        Some(Self {
+            object: ForwardEncodeObject::Object(ForwardEncodeState::new(obj.as_object(), table)),
+            sizes,
+            size_idx: 0,
+            encoded_len,
+            pending: [0; SLOP_SIZE],
+            pending_len: 0,
+            stack: Default::default(),
+        })
+    }
+
+    /// Total number of bytes the message encodes to.
+    pub fn encoded_len(&self) -> usize {
+        self.encoded_len
+    }
+
+    fn encode(&mut self, buffer: &mut [u8], limit: usize) -> Option<usize> {
+        let (cursor, _) = ForwardWriteCursor::new(buffer);
+        let begin = cursor.0;
+        let limit = unsafe { begin.add(limit) };
+        let object = core::mem::replace(&mut self.object, ForwardEncodeObject::Done);
+        let mut sizes = SizeCursor {
+            sizes: &self.sizes,
+            idx: self.size_idx,
+        };
+        let (cursor, object) = encode_forward(object, cursor, limit, &mut sizes, &mut self.stack)?;
+        self.size_idx = sizes.idx;
+        self.object = object;
+        Some((cursor - begin) as usize)
+    }
+
+    pub fn resume_encode(&mut self, chunk: &mut [u8]) -> Option<ForwardResult> {
+        let len = chunk.len();
+        let mut written = self.pending_len.min(len);
+        chunk[..written].copy_from_slice(&self.pending[..written]);
+        self.pending.copy_within(written..self.pending_len, 0);
+        self.pending_len -= written;
+        if self.pending_len > 0 {
+            return Some(ForwardResult::Full);
+        }
+        if len - written > SLOP_SIZE {
+            // Fields may overrun the limit by less than SLOP_SIZE bytes
+            written += self.encode(&mut chunk[written..], len - written - SLOP_SIZE)?;
+        }
+        // Finish the tail of the chunk through a patch buffer that absorbs the overrun
+        let mut patch_buffer = [0u8; 2 * SLOP_SIZE];
+        while !matches!(self.object, ForwardEncodeObject::Done) && written < len {
+            let remaining = len - written;
+            let n = self.encode(&mut patch_buffer, remaining)?;
+            let fits = n.min(remaining);
+            chunk[written..written + fits].copy_from_slice(&patch_buffer[..fits]);
+            written += fits;
+            self.pending[..n - fits].copy_from_slice(&patch_buffer[fits..n]);
+            self.pending_len = n - fits;
+        }
+        if matches!(self.object, ForwardEncodeObject::Done) && self.pending_len == 0 {
+            return Some(ForwardResult::Done(written));
+        }
+        Some(ForwardResult::Full)
+    }
+}
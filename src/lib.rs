@@ -1,8 +1,15 @@
 #![feature(likely_unlikely, allocator_api)]
 #![cfg_attr(not(feature = "std"), no_std)]
+#![cfg_attr(
+    feature = "tail_calls",
+    feature(explicit_tail_calls),
+    allow(incomplete_features)
+)]
 
 pub mod arena;
 pub mod base;
+#[cfg(feature = "std")]
+pub mod concurrent;
 pub mod containers;
 pub mod wire;
 
@@ -10,6 +17,10 @@ pub mod utils;
 
 pub mod decoding;
 pub mod encoding;
+#[cfg(feature = "std")]
+pub mod pool;
+#[cfg(feature = "std")]
+pub mod projection;
 pub mod reflection;
 pub mod tables;
 
@@ -61,54 +72,144 @@ pub trait ProtobufRef<'pool> {
         Ok(buf)
     }
 
+    /// Exact number of bytes the message encodes to, or None if messages nest deeper than
+    /// `STACK_DEPTH`.
+    fn encoded_len<const STACK_DEPTH: usize>(&self) -> Option<usize> {
+        encoding::encoded_len(self.as_object(), self.table(), STACK_DEPTH)
+    }
+
     #[cfg(feature = "std")]
     fn encode_vec<const STACK_DEPTH: usize>(&self) -> anyhow::Result<Vec<u8>> {
-        let mut buffer = vec![0u8; 1024];
-        let mut stack = Vec::new();
+        let mut buffer = Vec::new();
+        self.encode_into_vec::<STACK_DEPTH>(&mut buffer)?;
+        Ok(buffer)
+    }
+
+    /// Appends the encoded message to `buffer`. The exact size is computed up front, so
+    /// this allocates at most once and not at all when `buffer` has enough capacity. The
+    /// message is encoded straight into the spare capacity, without filling it first.
+    #[cfg(feature = "std")]
+    fn encode_into_vec<const STACK_DEPTH: usize>(
+        &self,
+        buffer: &mut Vec<u8>,
+    ) -> anyhow::Result<()> {
+        let len = encoding::encoded_len(self.as_object(), self.table(), STACK_DEPTH)
+            .ok_or(anyhow::anyhow!("Message tree too deep"))?;
+        if len == 0 {
+            return Ok(());
+        }
+        buffer.reserve(len);
+        let spare = &mut buffer.spare_capacity_mut()[..len];
+        // The encoder only writes, except for the first bytes of the buffer, which it
+        // reads back through its patch buffer once it has encoded past them.
+        spare[..len.min(wire::SLOP_SIZE)].fill(core::mem::MaybeUninit::new(0));
+        // SAFETY: Bytes are written before they are read
+        let spare = unsafe { core::slice::from_raw_parts_mut(spare.as_mut_ptr() as *mut u8, len) };
         let mut resumeable_encode = encoding::ResumeableEncode::<STACK_DEPTH>::new(self);
+        match resumeable_encode.resume_encode(spare) {
+            Some(encoding::ResumeResult::Done(buf)) if buf.len() == len => {
+                // SAFETY: The encoder wrote all len bytes
+                unsafe { buffer.set_len(buffer.len() + len) };
+                Ok(())
+            }
+            None => Err(anyhow::anyhow!("Message tree too deep")),
+            _ => Err(anyhow::anyhow!("Encoded size differs from encoded_len")),
+        }
+    }
+
+    /// Streams the encoded message into `writer` in chunks of `CHUNK_SIZE` bytes. Bytes
+    /// are produced front to back, so the first chunk is written before the rest of the
+    /// message is encoded. The submessage sizes are cached in `arena`.
+    #[cfg(feature = "std")]
+    fn encode_to_write<const STACK_DEPTH: usize, const CHUNK_SIZE: usize>(
+        &self,
+        arena: &mut crate::arena::Arena,
+        writer: &mut impl std::io::Write,
+    ) -> anyhow::Result<()> {
+        let mut encoder = encoding::ForwardEncode::<STACK_DEPTH>::new(self, arena)
+            .ok_or(anyhow::anyhow!("Message tree too deep"))?;
+        let mut chunk = [0u8; CHUNK_SIZE];
         loop {
-            match resumeable_encode
-                .resume_encode(&mut buffer)
+            match encoder
+                .resume_encode(&mut chunk)
                 .ok_or(anyhow::anyhow!("Message tree too deep"))?
             {
-                encoding::ResumeResult::Done(buf) => {
-                    let len = buf.len();
-                    let end = buffer.len();
-                    let start = end - len;
-                    buffer.copy_within(start..end, 0);
-                    buffer.truncate(len);
-                    break;
-                }
-                encoding::ResumeResult::NeedsMoreBuffer => {
-                    let len = buffer.len().min(1024 * 1024);
-                    stack.push(core::mem::take(&mut buffer));
-                    buffer = vec![0u8; len * 2];
+                encoding::ForwardResult::Done(len) => {
+                    writer.write_all(&chunk[..len])?;
+                    return Ok(());
                 }
-            };
-        }
-        while let Some(old_buffer) = stack.pop() {
-            buffer.extend_from_slice(&old_buffer);
+                encoding::ForwardResult::Full => writer.write_all(&chunk)?,
+            }
         }
-        Ok(buffer)
     }
 }
 
 /// Mutable protobuf operations (decode, deserialize).
 /// Extends ProtobufRef with mutation capabilities.
+///
+/// A failed decode frees everything it allocated from the arena and leaves the message
+/// cleared, as it may have been partially filled with that memory.
 pub trait ProtobufMut<'pool>: ProtobufRef<'pool> {
     fn as_object_mut(&mut self) -> &mut base::Object;
 
+    /// Clears the message for decoding into it again, keeping its memory. Bytes and
+    /// repeated fields keep their capacity, and submessages are cleared and recycled in
+    /// `arena`, where the decoder reuses them. Decoding similar messages into one long
+    /// lived message thus stops allocating from the arena after the first few decodes.
+    ///
+    /// # Safety
+    /// Everything the message references must have been allocated from `arena`, or from
+    /// an arena that outlives it, and not be shared with other messages. Submessages
+    /// obtained through a lazy field live in an arena of their own and must not be
+    /// cleared with the arena of the parent.
+    unsafe fn reuse_clear(&mut self, arena: &mut crate::arena::Arena) {
+        let table = self.table();
+        // SAFETY: Guaranteed by the caller
+        unsafe { self.as_object_mut().reuse_clear(table, arena) };
+    }
+
     #[must_use]
     fn decode_flat<const STACK_DEPTH: usize>(
         &mut self,
         arena: &mut crate::arena::Arena,
         buf: &[u8],
     ) -> bool {
+        let checkpoint = arena.checkpoint();
         let mut decoder = decoding::ResumeableDecode::<STACK_DEPTH>::new(self, isize::MAX);
-        if !decoder.resume(buf, arena) {
-            return false;
+        if decoder.resume(buf, arena) && decoder.finish(arena) {
+            return true;
+        }
+        rollback_decode(self, arena, checkpoint);
+        false
+    }
+
+    /// Decodes `buf` without copying bytes and string payloads: they point into `buf`,
+    /// which the returned message borrows. The message is read only, since writing to an
+    /// aliased field would write into the input. Only owned messages can be decoded this
+    /// way, as a `DynamicMessage` borrows an object that would outlive the `Aliased`.
+    #[must_use]
+    fn decode_flat_aliased<'buf, const STACK_DEPTH: usize>(
+        mut self,
+        arena: &mut crate::arena::Arena,
+        buf: &'buf [u8],
+    ) -> Option<Aliased<'buf, Self>>
+    where
+        Self: Protobuf,
+    {
+        let checkpoint = arena.checkpoint();
+        // SAFETY: Self owns its object, so Aliased borrows buf for as long as the message
+        // lives, and only hands out shared references.
+        let mut decoder = unsafe {
+            decoding::ResumeableDecode::<STACK_DEPTH>::new_aliased(&mut self, isize::MAX)
+        };
+        if !decoder.resume(buf, arena) || !decoder.finish(arena) {
+            rollback_decode(&mut self, arena, checkpoint);
+            return None;
         }
-        decoder.finish(arena)
+        Some(Aliased {
+            msg: self,
+            buf: core::marker::PhantomData,
+        })
     }
 
     fn decode<'a, E: core::error::Error + Send + Sync + 'static>(
@@ -116,19 +217,26 @@ pub trait ProtobufMut<'pool>: ProtobufRef<'pool> {
         arena: &mut crate::arena::Arena,
         provider: &'a mut impl FnMut() -> Result<Option<&'a [u8]>, E>,
     ) -> anyhow::Result<()> {
-        let mut decoder = decoding::ResumeableDecode::<32>::new(self, isize::MAX);
-        loop {
-            let Some(buffer) = provider()? else {
-                break;
-            };
-            if !decoder.resume(buffer, arena) {
+        let checkpoint = arena.checkpoint();
+        let result = (|| {
+            let mut decoder = decoding::ResumeableDecode::<32>::new(self, isize::MAX);
+            loop {
+                let Some(buffer) = provider()? else {
+                    break;
+                };
+                if !decoder.resume(buffer, arena) {
+                    return Err(anyhow::anyhow!("decode error"));
+                }
+            }
+            if !decoder.finish(arena) {
                 return Err(anyhow::anyhow!("decode error"));
             }
+            Ok(())
+        })();
+        if result.is_err() {
+            rollback_decode(self, arena, checkpoint);
         }
-        if !decoder.finish(arena) {
-            return Err(anyhow::anyhow!("decode error"));
-        }
-        Ok(())
+        result
     }
 
     fn async_decode<'a, E: core::error::Error + Send + Sync + 'static, F>(
@@ -140,19 +248,27 @@ pub trait ProtobufMut<'pool>: ProtobufRef<'pool> {
         F: core::future::Future<Output = Result<Option<&'a [u8]>, E>> + 'a,
     {
         async move {
-            let mut decoder = decoding::ResumeableDecode::<32>::new(self, isize::MAX);
-            loop {
-                let Some(buffer) = provider().await? else {
-                    break;
-                };
-                if !decoder.resume(buffer, arena) {
+            let checkpoint = arena.checkpoint();
+            let result = async {
+                let mut decoder = decoding::ResumeableDecode::<32>::new(self, isize::MAX);
+                loop {
+                    let Some(buffer) = provider().await? else {
+                        break;
+                    };
+                    if !decoder.resume(buffer, arena) {
+                        return Err(anyhow::anyhow!("decode error"));
+                    }
+                }
+                if !decoder.finish(arena) {
                     return Err(anyhow::anyhow!("decode error"));
                 }
+                Ok(())
             }
-            if !decoder.finish(arena) {
-                return Err(anyhow::anyhow!("decode error"));
+            .await;
+            if result.is_err() {
+                rollback_decode(self, arena, checkpoint);
             }
-            Ok(())
+            result
         }
     }
 
@@ -162,22 +278,29 @@ pub trait ProtobufMut<'pool>: ProtobufRef<'pool> {
         arena: &mut crate::arena::Arena,
         reader: &mut impl std::io::BufRead,
     ) -> anyhow::Result<()> {
-        let mut decoder = decoding::ResumeableDecode::<STACK_DEPTH>::new(self, isize::MAX);
-        loop {
-            let buffer = reader.fill_buf()?;
-            let len = buffer.len();
-            if len == 0 {
-                break;
+        let checkpoint = arena.checkpoint();
+        let result = (|| {
+            let mut decoder = decoding::ResumeableDecode::<STACK_DEPTH>::new(self, isize::MAX);
+            loop {
+                let buffer = reader.fill_buf()?;
+                let len = buffer.len();
+                if len == 0 {
+                    break;
+                }
+                if !decoder.resume(buffer, arena) {
+                    return Err(anyhow::anyhow!("decode error"));
+                }
+                reader.consume(len);
             }
-            if !decoder.resume(buffer, arena) {
+            if !decoder.finish(arena) {
                 return Err(anyhow::anyhow!("decode error"));
             }
-            reader.consume(len);
-        }
-        if !decoder.finish(arena) {
-            return Err(anyhow::anyhow!("decode error"));
+            Ok(())
+        })();
+        if result.is_err() {
+            rollback_decode(self, arena, checkpoint);
         }
-        Ok(())
+        result
     }
 
     #[cfg(feature = "std")]
@@ -198,22 +321,31 @@ pub trait ProtobufMut<'pool>: ProtobufRef<'pool> {
         use futures::io::AsyncBufReadExt;
 
         async move {
-            let mut decoder = decoding::ResumeableDecode::<STACK_DEPTH>::new(self, isize::MAX);
-            loop {
-                let buffer = reader.fill_buf().await?;
-                let len = buffer.len();
-                if len == 0 {
-                    break;
+            let checkpoint = arena.checkpoint();
+            let result = async {
+                let mut decoder =
+                    decoding::ResumeableDecode::<STACK_DEPTH>::new(self, isize::MAX);
+                loop {
+                    let buffer = reader.fill_buf().await?;
+                    let len = buffer.len();
+                    if len == 0 {
+                        break;
+                    }
+                    if !decoder.resume(buffer, arena) {
+                        return Err(anyhow::anyhow!("decode error"));
+                    }
+                    reader.consume_unpin(len);
                 }
-                if !decoder.resume(buffer, arena) {
+                if !decoder.finish(arena) {
                     return Err(anyhow::anyhow!("decode error"));
                 }
-                reader.consume_unpin(len);
+                Ok(())
             }
-            if !decoder.finish(arena) {
-                return Err(anyhow::anyhow!("decode error"));
+            .await;
+            if result.is_err() {
+                rollback_decode(self, arena, checkpoint);
             }
-            Ok(())
+            result
         }
     }
 
@@ -243,6 +375,36 @@ pub trait ProtobufMut<'pool>: ProtobufRef<'pool> {
     }
 }
 
+// Undoes a failed decode: frees what it allocated and clears the message, which may
+// point into the freed memory.
+fn rollback_decode<'pool, T: ProtobufMut<'pool> + ?Sized>(
+    msg: &mut T,
+    arena: &mut crate::arena::Arena,
+    checkpoint: crate::arena::Checkpoint,
+) {
+    let size = msg.table().size as usize;
+    // SAFETY: Only the cleared message referenced memory allocated since the checkpoint
+    unsafe {
+        arena.rollback(checkpoint);
+        core::ptr::write_bytes(msg.as_object_mut() as *mut base::Object as *mut u8, 0, size);
+    }
+}
+
+/// A message decoded by `decode_flat_aliased`, whose bytes and string fields may point into
+/// the input buffer.
+pub struct Aliased<'buf, T> {
+    msg: T,
+    buf: core::marker::PhantomData<&'buf [u8]>,
+}
+
+impl<T> core::ops::Deref for Aliased<'_, T> {
+    type Target = T;
+
+    fn deref(&self) -> &T {
+        &self.msg
+    }
+}
+
 // Blanket impl for static protobuf types
 impl<T: Protobuf> ProtobufRef<'static> for T {
     fn table(&self) -> &'static tables::Table {
@@ -305,6 +467,55 @@ pub mod tests {
         );
     }
 
+    #[test]
+    fn packed_varint_roundtrip() {
+        use crate::google::protobuf::SourceCodeInfo::Location::ProtoType as Location;
+        let mut arena = crate::arena::Arena::new(&std::alloc::Global);
+        let mut msg = Location::default();
+        // Runs of single byte values interleaved with multi byte and negative values, so
+        // the bulk unpacker sees both kinds of 16 byte blocks.
+        for i in 0..200i32 {
+            let val = match i % 37 {
+                0 => -i,
+                1 => i << 20,
+                2 => i32::MIN + i,
+                _ => i % 100,
+            };
+            msg.path_mut().push(val, &mut arena);
+            msg.span_mut().push(i % 3, &mut arena);
+        }
+        assert_roundtrip(&msg);
+
+        let data = msg.encode_vec::<32>().expect("msg should encode");
+        let mut decoded = Location::default();
+        assert!(decoded.decode_flat::<32>(&mut arena, &data));
+        assert_eq!(decoded.path(), msg.path());
+        assert_eq!(decoded.span(), msg.span());
+    }
+
+    #[test]
+    fn fast_tables_match_dynamic_tables() {
+        use crate::google::protobuf::{FieldDescriptorProto, FileDescriptorProto, FileOptions};
+        let mut pool = crate::reflection::DescriptorPool::new(&std::alloc::Global);
+        pool.add_file(FileDescriptorProto::ProtoType::file_descriptor());
+        for table in [
+            <FileDescriptorProto::ProtoType as crate::Protobuf>::table(),
+            <FieldDescriptorProto::ProtoType as crate::Protobuf>::table(),
+            <FileOptions::ProtoType as crate::Protobuf>::table(),
+        ] {
+            let name = format!("google.protobuf.{}", table.descriptor.name());
+            let dynamic_table = pool.get_table(&name).expect("table should exist");
+            for (slot, (a, b)) in table
+                .fast_entries()
+                .iter()
+                .zip(dynamic_table.fast_entries())
+                .enumerate()
+            {
+                assert!(a == b, "fast slot {} of {} differs", slot, name);
+            }
+        }
+    }
+
     #[test]
     fn dynamic_file_descriptor_roundtrip() {
         let mut pool = crate::reflection::DescriptorPool::new(&std::alloc::Global);
@@ -324,4 +535,81 @@ pub mod tests {
 
         assert_eq!(bytes, roundtrip);
     }
+
+    #[test]
+    fn dynamic_inline_repeated_messages_roundtrip() {
+        use crate::reflection::{LayoutOptions, Value};
+
+        let layout = LayoutOptions {
+            inline_repeated_messages: true,
+            ..Default::default()
+        };
+        let mut pool = crate::reflection::DescriptorPool::with_layout(&std::alloc::Global, layout);
+        let file_descriptor =
+            crate::google::protobuf::FileDescriptorProto::ProtoType::file_descriptor();
+        pool.add_file(&file_descriptor);
+
+        let bytes = file_descriptor.encode_vec::<32>().expect("should encode");
+        let mut arena = crate::arena::Arena::new(&std::alloc::Global);
+        let dynamic_file_descriptor = pool
+            .decode_message("google.protobuf.FileDescriptorProto", &bytes, &mut arena)
+            .expect("should decode");
+        let roundtrip = dynamic_file_descriptor
+            .encode_vec::<32>()
+            .expect("should encode");
+        assert_eq!(bytes, roundtrip);
+
+        // The message types are stored one after the other
+        let field = dynamic_file_descriptor
+            .find_field_descriptor("message_type")
+            .unwrap();
+        let Some(Value::RepeatedMessage(messages)) = dynamic_file_descriptor.get_field(field) else {
+            panic!("message_type should be set");
+        };
+        assert_eq!(messages.len(), file_descriptor.message_type().len());
+        let stride = messages.table().size as usize;
+        for i in 1..messages.len() {
+            let prev = messages.get(i - 1).as_object() as *const _ as usize;
+            assert_eq!(messages.get(i).as_object() as *const _ as usize, prev + stride);
+        }
+    }
+
+    #[test]
+    fn dynamic_inline_messages_roundtrip() {
+        use crate::reflection::{DescriptorPool, LayoutOptions, MAX_INLINE_STRUCT_SIZE};
+
+        let file_descriptor =
+            crate::google::protobuf::FileDescriptorProto::ProtoType::file_descriptor();
+        let mut default_pool = DescriptorPool::new(&std::alloc::Global);
+        default_pool.add_file(&file_descriptor);
+        let layout = LayoutOptions {
+            max_inline_message_size: MAX_INLINE_STRUCT_SIZE,
+            ..Default::default()
+        };
+        let mut pool = DescriptorPool::with_layout(&std::alloc::Global, layout);
+        pool.add_file(&file_descriptor);
+
+        // Options are embedded, up to the struct size limit
+        for name in ["FileDescriptorProto", "FieldDescriptorProto", "FieldOptions"] {
+            let name = format!("google.protobuf.{}", name);
+            let size = pool.get_table(&name).unwrap().size as u32;
+            assert!(size <= MAX_INLINE_STRUCT_SIZE);
+            let default_size = default_pool.get_table(&name).unwrap().size as u32;
+            assert!(size > default_size, "{} has no inline fields", name);
+        }
+
+        let bytes = file_descriptor.encode_vec::<32>().expect("should encode");
+        let mut arena = crate::arena::Arena::new(&std::alloc::Global);
+        let dynamic_file_descriptor = pool
+            .decode_message("google.protobuf.FileDescriptorProto", &bytes, &mut arena)
+            .expect("should decode");
+        let roundtrip = dynamic_file_descriptor
+            .encode_vec::<32>()
+            .expect("should encode");
+        assert_eq!(bytes, roundtrip);
+        assert_eq!(
+            format!("{:?}", dynamic_file_descriptor),
+            format!("{:?}", file_descriptor)
+        );
+    }
 }
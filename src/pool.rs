@@ -0,0 +1,473 @@
+use std::alloc::Allocator;
+use std::cell::RefCell;
+use std::ops::{Deref, DerefMut};
+use std::sync::atomic::{AtomicBool, AtomicU32, AtomicUsize, Ordering};
+use std::sync::{Arc, Condvar, Mutex};
+
+use crate::arena::{Arena, BlockChain, GrowthPolicy, SendArena};
+
+// Chains kept per thread before they go to the shared overflow list
+const THREAD_CAPACITY: usize = 4;
+// Number of released arenas after which the usage histogram is halved
+const DECAY_INTERVAL: usize = 1024;
+const BUCKETS: usize = usize::BITS as usize;
+
+static NEXT_POOL: AtomicUsize = AtomicUsize::new(0);
+
+std::thread_local! {
+    // Chains this thread keeps, one cache for each pool it used
+    static CACHES: RefCell<Vec<Arc<ThreadCache>>> = const { RefCell::new(Vec::new()) };
+}
+
+// Chains kept for one thread of a pool. The lock is only contended when a thread without
+// blocks takes them from another thread, or when the pool is dropped.
+struct ThreadCache {
+    pool: usize,
+    chains: Mutex<Vec<BlockChain>>,
+}
+
+/// Hands out arenas for request-per-arena servers. When a pooled arena is dropped its
+/// blocks are kept and handed to the next arena, so in steady state requests do not call
+/// the allocator at all. Each thread keeps the blocks of its last few arenas in a thread
+/// local cache, the rest go to a list shared by all threads. A thread whose cache and the
+/// shared list are empty takes blocks cached by other threads, including threads that have
+/// exited. A pooled arena that was replaced by one with another allocator is simply
+/// dropped.
+///
+/// The pool records how much memory released arenas used. Blocks beyond what 90% of
+/// recent arenas needed are freed on release, and an arena that cannot be given blocks
+/// starts with a first block of that size. Retained memory is capped by `max_retained`
+/// for the whole pool.
+///
+/// Releasing an arena walks all its blocks, which for large arenas shows in the latency of
+/// the request that drops it. A pool created with `deferred` only queues dropped arenas,
+/// and leaves releasing them to `reclaim`, called by the owner or by a background thread
+/// in `run_reclaimer`. `get` never releases queued arenas itself, it only takes blocks
+/// that were already reclaimed.
+pub struct ArenaPool<'a> {
+    allocator: &'a (dyn Allocator + Sync),
+    max_retained: usize,
+    retained: AtomicUsize,
+    id: usize,
+    // The thread caches of this pool, to take blocks from and to free them on drop
+    caches: Mutex<Vec<Arc<ThreadCache>>>,
+    overflow: Mutex<Vec<BlockChain>>,
+    // Number of recent arenas that used less than 2^i bytes
+    histogram: [AtomicU32; BUCKETS],
+    releases: AtomicUsize,
+    // Dropped arenas waiting for reclaim, None when arenas are released on drop
+    deferred: Option<Mutex<Vec<SendArena<'a>>>>,
+    queued: Condvar,
+    stopped: AtomicBool,
+}
+
+impl<'a> ArenaPool<'a> {
+    pub fn new(allocator: &'a (dyn Allocator + Sync), max_retained: usize) -> Self {
+        Self::with_queue(allocator, max_retained, None)
+    }
+
+    /// Creates a pool whose arenas are queued when dropped and released by `reclaim`.
+    pub fn deferred(allocator: &'a (dyn Allocator + Sync), max_retained: usize) -> Self {
+        Self::with_queue(allocator, max_retained, Some(Mutex::new(Vec::new())))
+    }
+
+    fn with_queue(
+        allocator: &'a (dyn Allocator + Sync),
+        max_retained: usize,
+        deferred: Option<Mutex<Vec<SendArena<'a>>>>,
+    ) -> Self {
+        ArenaPool {
+            allocator,
+            max_retained,
+            retained: AtomicUsize::new(0),
+            id: NEXT_POOL.fetch_add(1, Ordering::Relaxed),
+            caches: Mutex::new(Vec::new()),
+            overflow: Mutex::new(Vec::new()),
+            histogram: [const { AtomicU32::new(0) }; BUCKETS],
+            releases: AtomicUsize::new(0),
+            deferred,
+            queued: Condvar::new(),
+            stopped: AtomicBool::new(false),
+        }
+    }
+
+    pub fn get(&self) -> PooledArena<'_, 'a> {
+        let mut arena = Arena::new(self.allocator);
+        if let Some(chain) = self.pop() {
+            // SAFETY: All chains in the pool come from arenas with our allocator
+            unsafe { arena.add_retained(chain) };
+        } else {
+            let typical = self.typical_usage();
+            arena.set_growth_policy(GrowthPolicy {
+                initial_block_size: typical.max(GrowthPolicy::DEFAULT.initial_block_size),
+                ..GrowthPolicy::DEFAULT
+            });
+        }
+        PooledArena { arena, pool: self }
+    }
+
+    /// Bytes of blocks currently kept by the pool.
+    pub fn retained_bytes(&self) -> usize {
+        self.retained.load(Ordering::Relaxed)
+    }
+
+    /// Releases the arenas queued by a `deferred` pool, keeping their blocks for reuse like
+    /// a pool that releases on drop. Returns the number of arenas released.
+    pub fn reclaim(&self) -> usize {
+        let Some(deferred) = &self.deferred else {
+            return 0;
+        };
+        let arenas = core::mem::take(&mut *deferred.lock().unwrap());
+        let count = arenas.len();
+        for SendArena(mut arena) in arenas {
+            // The blocks go to the shared list, the reclaiming thread serves no requests
+            self.release(&mut arena, false);
+        }
+        count
+    }
+
+    /// Calls `reclaim` whenever arenas are queued, until `stop_reclaimer` is called. Meant
+    /// to be run by a dedicated thread.
+    pub fn run_reclaimer(&self) {
+        let Some(deferred) = &self.deferred else {
+            return;
+        };
+        loop {
+            {
+                let mut queue = deferred.lock().unwrap();
+                while queue.is_empty() && !self.stopped.load(Ordering::Relaxed) {
+                    queue = self.queued.wait(queue).unwrap();
+                }
+                if queue.is_empty() {
+                    return;
+                }
+            }
+            self.reclaim();
+        }
+    }
+
+    /// Makes `run_reclaimer` return once the queue is empty.
+    pub fn stop_reclaimer(&self) {
+        if let Some(deferred) = &self.deferred {
+            let _queue = deferred.lock().unwrap();
+            self.stopped.store(true, Ordering::Relaxed);
+            self.queued.notify_all();
+        }
+    }
+
+    // Runs `f` on the chains cached for this thread, or on None while the thread locals of
+    // an exiting thread are destroyed.
+    fn with_thread_cache<R>(&self, f: impl FnOnce(Option<&mut Vec<BlockChain>>) -> R) -> R {
+        let mut f = Some(f);
+        let result = CACHES.try_with(|caches| {
+            let mut caches = caches.borrow_mut();
+            let index = match caches.iter().position(|cache| cache.pool == self.id) {
+                Some(index) => index,
+                None => {
+                    // Forget the caches of pools that were dropped
+                    caches.retain(|cache| Arc::strong_count(cache) > 1);
+                    let cache = Arc::new(ThreadCache {
+                        pool: self.id,
+                        chains: Mutex::new(Vec::new()),
+                    });
+                    self.caches.lock().unwrap().push(cache.clone());
+                    caches.push(cache);
+                    caches.len() - 1
+                }
+            };
+            let f = f.take().unwrap();
+            f(Some(&mut caches[index].chains.lock().unwrap()))
+        });
+        result.unwrap_or_else(|_| f.take().unwrap()(None))
+    }
+
+    fn pop(&self) -> Option<BlockChain> {
+        let chain = self
+            .with_thread_cache(|chains| chains?.pop())
+            .or_else(|| self.overflow.lock().unwrap().pop())
+            .or_else(|| self.steal())?;
+        self.retained.fetch_sub(chain.bytes, Ordering::Relaxed);
+        Some(chain)
+    }
+
+    // Takes a chain cached by another thread. Caches of exited threads, which only the
+    // pool still references, are emptied into the shared list and forgotten.
+    fn steal(&self) -> Option<BlockChain> {
+        let mut caches = self.caches.lock().unwrap();
+        let mut overflow = self.overflow.lock().unwrap();
+        caches.retain(|cache| {
+            let exited = Arc::strong_count(cache) == 1;
+            if exited {
+                overflow.append(&mut cache.chains.lock().unwrap());
+            }
+            !exited
+        });
+        overflow.pop().or_else(|| {
+            caches
+                .iter()
+                .find_map(|cache| cache.chains.lock().unwrap().pop())
+        })
+    }
+
+    // Keeps a chain on the list of this thread if `local`, otherwise on the shared list
+    fn push(&self, chain: BlockChain, local: bool) -> Result<(), BlockChain> {
+        let retained = self.retained.fetch_add(chain.bytes, Ordering::Relaxed);
+        if retained + chain.bytes > self.max_retained {
+            self.retained.fetch_sub(chain.bytes, Ordering::Relaxed);
+            return Err(chain);
+        }
+        let chain = if local {
+            self.with_thread_cache(|chains| match chains {
+                Some(chains) if chains.len() < THREAD_CAPACITY => {
+                    chains.push(chain);
+                    None
+                }
+                _ => Some(chain),
+            })
+        } else {
+            Some(chain)
+        };
+        if let Some(chain) = chain {
+            self.overflow.lock().unwrap().push(chain);
+        }
+        Ok(())
+    }
+
+    // Keeps the blocks of a dropped arena, or frees them. An arena that was replaced by
+    // one with another allocator is left to free its own blocks.
+    fn release(&self, arena: &mut Arena<'a>, local: bool) {
+        if !arena.uses_allocator(self.allocator) {
+            return;
+        }
+        self.record_usage(arena.bytes_allocated());
+        let limit = self.typical_usage();
+        arena.set_retention(limit, limit);
+        let chain = arena.take_retained();
+        if chain.bytes == 0 {
+            return;
+        }
+        if let Err(chain) = self.push(chain, local) {
+            free_chain(self.allocator, chain);
+        }
+    }
+
+    fn record_usage(&self, bytes: usize) {
+        let bucket = (usize::BITS - bytes.leading_zeros()) as usize;
+        self.histogram[bucket.min(BUCKETS - 1)].fetch_add(1, Ordering::Relaxed);
+        if self.releases.fetch_add(1, Ordering::Relaxed) % DECAY_INTERVAL == DECAY_INTERVAL - 1 {
+            for count in &self.histogram {
+                count.store(count.load(Ordering::Relaxed) / 2, Ordering::Relaxed);
+            }
+        }
+    }
+
+    // Bytes that 90% of recent arenas fit in, 0 without history.
+    fn typical_usage(&self) -> usize {
+        let counts = self
+            .histogram
+            .each_ref()
+            .map(|c| c.load(Ordering::Relaxed) as u64);
+        let total: u64 = counts.iter().sum();
+        let mut cumulative = 0;
+        for (bucket, &count) in counts.iter().enumerate() {
+            cumulative += count;
+            if cumulative * 10 >= total * 9 && cumulative > 0 {
+                return 1usize.checked_shl(bucket as u32).unwrap_or(usize::MAX);
+            }
+        }
+        0
+    }
+}
+
+impl Drop for ArenaPool<'_> {
+    fn drop(&mut self) {
+        if let Some(deferred) = &mut self.deferred {
+            // The arenas free their blocks when dropped
+            deferred.get_mut().unwrap().clear();
+        }
+        // Threads forget the caches of this pool once it no longer references them
+        for cache in self.caches.get_mut().unwrap().drain(..) {
+            for chain in cache.chains.lock().unwrap().drain(..) {
+                free_chain(self.allocator, chain);
+            }
+        }
+        for chain in self.overflow.get_mut().unwrap().drain(..) {
+            free_chain(self.allocator, chain);
+        }
+    }
+}
+
+fn free_chain(allocator: &(dyn Allocator + Sync), chain: BlockChain) {
+    let mut arena = Arena::new(allocator);
+    // SAFETY: The chain was allocated with the allocator of the pool
+    unsafe { arena.add_retained(chain) };
+}
+
+/// An arena from an `ArenaPool`, which returns its blocks to the pool when dropped.
+pub struct PooledArena<'p, 'a> {
+    arena: Arena<'a>,
+    pool: &'p ArenaPool<'a>,
+}
+
+impl<'a> Deref for PooledArena<'_, 'a> {
+    type Target = Arena<'a>;
+
+    fn deref(&self) -> &Arena<'a> {
+        &self.arena
+    }
+}
+
+impl<'a> DerefMut for PooledArena<'_, 'a> {
+    fn deref_mut(&mut self) -> &mut Arena<'a> {
+        &mut self.arena
+    }
+}
+
+impl Drop for PooledArena<'_, '_> {
+    fn drop(&mut self) {
+        let pool = self.pool;
+        let Some(deferred) = &pool.deferred else {
+            pool.release(&mut self.arena, true);
+            return;
+        };
+        // Only arenas with the Sync allocator of the pool may go to the reclaiming thread
+        if !self.arena.uses_allocator(pool.allocator) {
+            return;
+        }
+        let arena = core::mem::replace(&mut self.arena, Arena::new(pool.allocator));
+        deferred.lock().unwrap().push(SendArena(arena));
+        pool.queued.notify_one();
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use core::alloc::{AllocError, Layout};
+    use core::ptr::NonNull;
+    use std::alloc::Global;
+
+    struct CountingAllocator(AtomicUsize);
+
+    unsafe impl Allocator for CountingAllocator {
+        fn allocate(&self, layout: Layout) -> Result<NonNull<[u8]>, AllocError> {
+            self.0.fetch_add(1, Ordering::Relaxed);
+            Global.allocate(layout)
+        }
+
+        unsafe fn deallocate(&self, ptr: NonNull<u8>, layout: Layout) {
+            unsafe { Global.deallocate(ptr, layout) }
+        }
+    }
+
+    fn request(arena: &mut Arena) {
+        for i in 0..2000 {
+            let slice = unsafe { &mut *arena.alloc_slice::<u64>(i % 20 + 1) };
+            slice.fill(i as u64);
+        }
+    }
+
+    #[test]
+    fn test_pool_reuses_blocks() {
+        let allocator = CountingAllocator(AtomicUsize::new(0));
+        let pool = ArenaPool::new(&allocator, usize::MAX);
+        std::thread::scope(|scope| {
+            for _ in 0..4 {
+                scope.spawn(|| {
+                    for _ in 0..100 {
+                        request(&mut pool.get());
+                    }
+                });
+            }
+        });
+        assert!(pool.retained_bytes() > 0);
+
+        let calls = allocator.0.load(Ordering::Relaxed);
+        for _ in 0..100 {
+            request(&mut pool.get());
+        }
+        assert_eq!(allocator.0.load(Ordering::Relaxed), calls);
+    }
+
+    #[test]
+    fn test_thread_cache() {
+        let pool = ArenaPool::new(&Global, usize::MAX);
+        request(&mut pool.get());
+        // The blocks stay with this thread, not on the shared list
+        assert!(pool.overflow.lock().unwrap().is_empty());
+        assert_eq!(pool.with_thread_cache(|chains| chains.unwrap().len()), 1);
+
+        // A thread without blocks takes them from the cache of another thread
+        std::thread::scope(|scope| {
+            scope.spawn(|| {
+                let arena = pool.get();
+                assert!(arena.bytes_allocated() > 0);
+                assert_eq!(pool.retained_bytes(), 0);
+            });
+        });
+        assert_eq!(pool.with_thread_cache(|chains| chains.unwrap().len()), 0);
+        assert!(pool.get().bytes_allocated() > 0);
+    }
+
+    #[test]
+    fn test_pool_caps_retained_memory() {
+        let pool = ArenaPool::new(&Global, 0);
+        for _ in 0..10 {
+            request(&mut pool.get());
+        }
+        assert_eq!(pool.retained_bytes(), 0);
+
+        // Without blocks to reuse, arenas start with a block of the typical size
+        let mut arena = pool.get();
+        arena.alloc::<u64>();
+        assert!(arena.bytes_allocated() >= pool.typical_usage());
+    }
+
+    #[test]
+    fn test_deferred_reclaim() {
+        let allocator = CountingAllocator(AtomicUsize::new(0));
+        let pool = ArenaPool::deferred(&allocator, usize::MAX);
+        request(&mut pool.get());
+        assert_eq!(pool.retained_bytes(), 0);
+        // Queued arenas are left to the reclaimer, get allocates anew
+        let calls = allocator.0.load(Ordering::Relaxed);
+        request(&mut pool.get());
+        assert!(allocator.0.load(Ordering::Relaxed) > calls);
+        assert_eq!(pool.reclaim(), 2);
+        assert!(pool.retained_bytes() > 0);
+
+        // Reclaimed blocks are reused
+        let calls = allocator.0.load(Ordering::Relaxed);
+        for _ in 0..100 {
+            request(&mut pool.get());
+            pool.reclaim();
+        }
+        assert_eq!(allocator.0.load(Ordering::Relaxed), calls);
+
+        std::thread::scope(|scope| {
+            scope.spawn(|| pool.run_reclaimer());
+            for _ in 0..100 {
+                request(&mut pool.get());
+            }
+            pool.stop_reclaimer();
+        });
+        assert_eq!(pool.reclaim(), 0);
+        assert!(pool.retained_bytes() > 0);
+    }
+
+    #[test]
+    fn test_pool_ignores_foreign_arenas() {
+        let allocator = CountingAllocator(AtomicUsize::new(0));
+        for pool in [
+            ArenaPool::new(&Global, usize::MAX),
+            ArenaPool::deferred(&Global, usize::MAX),
+        ] {
+            let mut arena = pool.get();
+            *arena = Arena::new(&allocator);
+            request(&mut arena);
+            drop(arena);
+            assert_eq!(pool.reclaim(), 0);
+            assert_eq!(pool.retained_bytes(), 0);
+        }
+    }
+}
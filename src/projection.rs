@@ -0,0 +1,198 @@
+use std::alloc::{Allocator, Layout};
+use std::collections::BTreeMap;
+
+use crate::{
+    ProtobufMut, ProtobufRef,
+    arena::Arena,
+    decoding::{self, FastEntry, NUM_FAST_ENTRIES},
+    encoding,
+    reflection::{DynamicMessage, DynamicMessageRef, is_lazy, is_message},
+    tables::{AuxTableEntry, Table},
+};
+
+/// Decode and encode tables restricted to a set of field paths, in the style of
+/// `google.protobuf.FieldMask` (e.g. `"a.b.c"`). When decoding, fields outside the paths
+/// are skipped like unknown fields, so they are never allocated or stored. When encoding,
+/// only the selected subtree is written.
+///
+/// A path that ends at a message field selects the whole submessage. Paths cannot
+/// descend into lazy fields, as those are decoded with the table of their own type.
+pub struct Projection<'a> {
+    source: &'a Table,
+    table: *const Table,
+    _arena: Arena<'a>,
+}
+
+#[derive(Default)]
+struct PathTree<'p> {
+    all: bool,
+    children: BTreeMap<&'p str, PathTree<'p>>,
+}
+
+impl<'a> Projection<'a> {
+    pub fn new(
+        table: &'a Table,
+        paths: &[&str],
+        allocator: &'a dyn Allocator,
+    ) -> anyhow::Result<Self> {
+        let mut tree = PathTree::default();
+        for path in paths {
+            let mut node = &mut tree;
+            for name in path.split('.') {
+                node = node.children.entry(name).or_default();
+            }
+            node.all = true;
+        }
+        let mut arena = Arena::new(allocator);
+        let projected = project(table, &tree, &mut arena)?;
+        Ok(Projection {
+            source: table,
+            table: projected,
+            _arena: arena,
+        })
+    }
+
+    pub fn table(&self) -> &Table {
+        unsafe { &*self.table }
+    }
+
+    /// View of `msg` that encodes only the selected fields.
+    pub fn view<'p, 'msg, 'pool, T: ProtobufRef<'pool> + ?Sized>(
+        &'p self,
+        msg: &'msg T,
+    ) -> DynamicMessageRef<'p, 'msg> {
+        assert!(
+            core::ptr::eq(msg.table(), self.source),
+            "Message type does not match the projection"
+        );
+        DynamicMessageRef {
+            object: msg.as_object(),
+            table: self.table(),
+        }
+    }
+
+    /// View of `msg` that decodes only the selected fields.
+    pub fn view_mut<'p, 'msg, 'pool, T: ProtobufMut<'pool> + ?Sized>(
+        &'p self,
+        msg: &'msg mut T,
+    ) -> DynamicMessage<'p, 'msg> {
+        assert!(
+            core::ptr::eq(msg.table(), self.source),
+            "Message type does not match the projection"
+        );
+        DynamicMessage {
+            object: msg.as_object_mut(),
+            table: self.table(),
+        }
+    }
+}
+
+// Copies the table with the fields outside the tree masked out, recursing into the
+// child tables of partially selected submessages.
+fn project(table: &Table, tree: &PathTree, arena: &mut Arena) -> anyhow::Result<*const Table> {
+    if tree.all {
+        return Ok(table);
+    }
+    let descriptor = table.descriptor;
+    for &name in tree.children.keys() {
+        if !descriptor.field().iter().any(|field| field.name() == name) {
+            anyhow::bail!("Field '{}' not found in '{}'", name, descriptor.name());
+        }
+    }
+    let selected = |field_number: u32| {
+        descriptor
+            .field()
+            .iter()
+            .find(|field| field.number() as u32 == field_number)
+            .and_then(|field| tree.children.get(field.name()))
+    };
+
+    let encode_entries: Vec<_> = table
+        .encode_entries()
+        .iter()
+        .filter(|entry| selected(entry.encoded_tag >> 3).is_some())
+        .copied()
+        .collect();
+    let num_decode_entries = table.num_decode_entries as usize;
+    let num_aux_entries = descriptor.field().iter().filter(|f| is_message(f)).count();
+
+    // Same layout as TableWithEntries, so offsets relative to the table are unchanged
+    let (layout, table_offset) = Layout::array::<encoding::TableEntry>(encode_entries.len())?
+        .extend(Layout::new::<Table>())?;
+    let (layout, fast_offset) = layout.extend(Layout::array::<FastEntry>(NUM_FAST_ENTRIES)?)?;
+    let (layout, decode_offset) =
+        layout.extend(Layout::array::<decoding::TableEntry>(num_decode_entries)?)?;
+    let (layout, aux_offset) = layout.extend(Layout::array::<AuxTableEntry>(num_aux_entries)?)?;
+
+    unsafe {
+        let base_ptr = arena.alloc_raw(layout).as_ptr();
+        let encode_ptr = base_ptr as *mut encoding::TableEntry;
+        let table_ptr = base_ptr.add(table_offset) as *mut Table;
+        let fast_ptr = base_ptr.add(fast_offset) as *mut FastEntry;
+        let decode_ptr = base_ptr.add(decode_offset) as *mut decoding::TableEntry;
+        let aux_ptr = base_ptr.add(aux_offset) as *mut AuxTableEntry;
+
+        encode_ptr.copy_from_nonoverlapping(encode_entries.as_ptr(), encode_entries.len());
+        table_ptr.write(Table {
+            num_encode_entries: encode_entries.len() as u16,
+            num_decode_entries: table.num_decode_entries,
+            size: table.size,
+            descriptor,
+        });
+
+        // Masked out fields keep their offset for reflection but decode as unknown
+        for (field_number, &entry) in table.decode_entries().iter().enumerate() {
+            let entry = if selected(field_number as u32).is_some() {
+                entry
+            } else {
+                decoding::TableEntry(entry.0 & !0xff)
+            };
+            decode_ptr.add(field_number).write(entry);
+        }
+
+        let source_aux = (table as *const Table as *const u8).add(aux_offset - table_offset)
+            as *const AuxTableEntry;
+        aux_ptr.copy_from_nonoverlapping(source_aux, num_aux_entries);
+        for &field in descriptor.field() {
+            let Some(subtree) = tree.children.get(field.name()) else {
+                continue;
+            };
+            if subtree.all {
+                continue;
+            }
+            if !is_message(field) {
+                anyhow::bail!("Field '{}' is not a message", field.name());
+            }
+            if is_lazy(field) {
+                anyhow::bail!("Cannot project into lazy field '{}'", field.name());
+            }
+            let entry = table.decode_entries()[field.number() as usize];
+            let aux = (table_ptr as *mut u8).add(entry.aux_offset() as usize) as *mut AuxTableEntry;
+            (*aux).child_table = project(&*(*aux).child_table, subtree, arena)?;
+        }
+
+        // Rebuild the fast entries, the lowest selected field number wins its slot
+        for i in 0..NUM_FAST_ENTRIES {
+            fast_ptr.add(i).write(FastEntry::EMPTY);
+        }
+        let mut fast_fields: Vec<_> = encode_entries
+            .iter()
+            .map(|entry| entry.encoded_tag)
+            .collect();
+        fast_fields.sort_unstable_by_key(|&encoded_tag| encoded_tag >> 3);
+        let mut used_slots = 0u32;
+        for encoded_tag in fast_fields {
+            let entry = *decode_ptr.add((encoded_tag >> 3) as usize);
+            let Some(slot) = decoding::fast_slot(entry.kind(), encoded_tag) else {
+                continue;
+            };
+            if used_slots & (1 << slot) != 0 {
+                continue;
+            }
+            used_slots |= 1 << slot;
+            fast_ptr.add(slot).write(FastEntry::new(encoded_tag, entry));
+        }
+
+        Ok(table_ptr)
+    }
+}
@@ -1,18 +1,360 @@
 use crate::{
     Protobuf, ProtobufRef, ProtobufMut,
-    arena::Arena,
-    base::{Message, Object},
+    base::{LazyMessage, Message, Object, RepeatedObjects},
     containers::{Bytes, String},
     google::protobuf::{
         DescriptorProto::ProtoType as DescriptorProto,
         FieldDescriptorProto::{Label, ProtoType as FieldDescriptorProto, Type},
-        FileDescriptorProto::ProtoType as FileDescriptorProto,
     },
     tables::Table,
     wire,
 };
+#[cfg(feature = "std")]
+use crate::{
+    arena::Arena,
+    google::protobuf::{
+        FeatureSet::{ProtoType as FeatureSet, Utf8Validation},
+        FileDescriptorProto::ProtoType as FileDescriptorProto,
+    },
+};
+
+/// Choices in how message structs are laid out in memory. Generated code and the tables
+/// of a `DescriptorPool` must use the same options for a message to be read by both.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct LayoutOptions {
+    /// Store the elements of repeated message fields inline and contiguously, `Table::size`
+    /// bytes apart, instead of as pointers to separately allocated objects. Groups keep
+    /// the pointer layout.
+    pub inline_repeated_messages: bool,
+    /// Embed singular message fields whose struct is at most this many bytes in the struct
+    /// of the parent, with presence tracked by a has bit, instead of pointing to a
+    /// separately allocated object. Messages that can contain themselves, lazy fields and
+    /// groups are never embedded. 0 disables embedding.
+    pub max_inline_message_size: u32,
+    /// Order the fields of a struct to minimize padding instead of in declaration order.
+    /// Fields of equal alignment keep their declaration order, so frequently used fields
+    /// declared first stay close together.
+    pub reorder_fields: bool,
+    /// Store the values of singular bool fields as bits of the has bits array, after the
+    /// has bits, instead of as a byte each.
+    pub bool_bits: bool,
+}
+
+/// Largest struct a message with embedded submessages may have. Embedded fields are
+/// turned back into pointers, last field first, until the struct fits.
+pub const MAX_INLINE_STRUCT_SIZE: u32 = 1024;
+
+/// Computes the struct layout of messages for some `LayoutOptions`. Generated code and
+/// `DescriptorPool` both lay out messages through this, so they agree on field offsets.
+///
+/// Files must be added before the files importing them, as in a `FileDescriptorSet`.
+#[cfg(feature = "std")]
+pub struct MessageLayouts<'a> {
+    options: LayoutOptions,
+    // Messages by full name, without the leading dot
+    messages: std::collections::HashMap<std::string::String, &'a DescriptorProto>,
+    layouts: std::collections::HashMap<*const DescriptorProto, MessageLayout>,
+    // Whether the string fields of a message validate UTF-8, unless a field overrides it
+    validates_utf8: std::collections::HashMap<*const DescriptorProto, bool>,
+}
+
+#[cfg(feature = "std")]
+impl<'a> MessageLayouts<'a> {
+    pub fn new(options: LayoutOptions) -> Self {
+        MessageLayouts {
+            options,
+            messages: std::collections::HashMap::new(),
+            layouts: std::collections::HashMap::new(),
+            validates_utf8: std::collections::HashMap::new(),
+        }
+    }
+
+    pub fn options(&self) -> LayoutOptions {
+        self.options
+    }
+
+    /// Make the messages of `file` known as children of the messages laid out after it.
+    pub fn add_file(&mut self, file: &'a FileDescriptorProto) {
+        // Proto3 and editions validate strings, proto2 leaves them unchecked
+        let validates_utf8 = validates_utf8(
+            file.options().and_then(|opts| opts.features()),
+            matches!(file.get_syntax(), Some("proto3" | "editions")),
+        );
+        for &message in file.message_type() {
+            self.add_message(file.package(), message, validates_utf8);
+        }
+    }
+
+    fn add_message(&mut self, scope: &str, message: &'a DescriptorProto, inherited_utf8: bool) {
+        let full_name = if scope.is_empty() {
+            message.name().to_string()
+        } else {
+            format!("{}.{}", scope, message.name())
+        };
+        let validates_utf8 =
+            validates_utf8(message.options().and_then(|opts| opts.features()), inherited_utf8);
+        for &nested in message.nested_type() {
+            self.add_message(&full_name, nested, validates_utf8);
+        }
+        self.messages.insert(full_name, message);
+        self.validates_utf8.insert(message, validates_utf8);
+    }
+
+    fn child(&self, field: &FieldDescriptorProto) -> Option<&'a DescriptorProto> {
+        let name = field.type_name();
+        self.messages
+            .get(name.strip_prefix('.').unwrap_or(name))
+            .copied()
+    }
+
+    // Whether the message can contain itself, directly or through other messages
+    fn is_recursive(&self, message: &'a DescriptorProto) -> bool {
+        let mut visited = std::collections::HashSet::new();
+        let mut stack = vec![message];
+        while let Some(current) = stack.pop() {
+            for &field in current.field() {
+                let Some(child) = is_message(field).then(|| self.child(field)).flatten() else {
+                    continue;
+                };
+                if core::ptr::eq(child, message) {
+                    return true;
+                }
+                if visited.insert(child as *const DescriptorProto) {
+                    stack.push(child);
+                }
+            }
+        }
+        false
+    }
+
+    /// Layout of the struct of `message`.
+    pub fn layout(&mut self, message: &'a DescriptorProto) -> MessageLayout {
+        if let Some(layout) = self.layouts.get(&(message as *const DescriptorProto)) {
+            return layout.clone();
+        }
+        let mut inline_fields = std::vec::Vec::new();
+        let max_size = self.options.max_inline_message_size;
+        for &field in message.field() {
+            if max_size == 0
+                || field.r#type() != Some(Type::TYPE_MESSAGE)
+                || is_repeated(field)
+                || is_lazy(field)
+            {
+                continue;
+            }
+            let Some(child) = self.child(field) else {
+                continue;
+            };
+            if self.is_recursive(child) {
+                continue;
+            }
+            let child_layout = self.layout(child);
+            if child_layout.size <= max_size {
+                inline_fields.push((field.number(), child_layout.size, child_layout.align));
+            }
+        }
+        let mut layout = self.struct_layout(message, &inline_fields);
+        while layout.size > MAX_INLINE_STRUCT_SIZE && inline_fields.pop().is_some() {
+            layout = self.struct_layout(message, &inline_fields);
+        }
+        let inherited_utf8 = self.validates_utf8.get(&(message as *const _)) == Some(&true);
+        layout.unchecked_strings = message
+            .field()
+            .iter()
+            .filter(|f| {
+                f.r#type() == Some(Type::TYPE_STRING)
+                    && !validates_utf8(f.options().and_then(|opts| opts.features()), inherited_utf8)
+            })
+            .map(|f| f.number())
+            .collect();
+        self.layouts.insert(message, layout.clone());
+        layout
+    }
+
+    fn struct_layout(
+        &self,
+        message: &DescriptorProto,
+        inline_fields: &[(i32, u32, u32)],
+    ) -> MessageLayout {
+        use std::alloc::Layout;
+
+        let num_has_bits =
+            message.field().iter().filter(|f| needs_has_bit(f)).count() + inline_fields.len();
+        // Bools stored as bits follow the has bits, in declaration order
+        let bool_bits: std::vec::Vec<_> = (0..message.field().len())
+            .filter(|&i| {
+                field_kind_tokens(&message.field()[i], self.options) == wire::FieldKind::BoolBit
+            })
+            .collect();
+        let has_bits_words = (num_has_bits + bool_bits.len()).div_ceil(32);
+        // has_bits is always a u32 array, so alignment is 4
+        let has_bits = Layout::from_size_align(has_bits_words * 4, 4).unwrap();
+        let field_layouts: std::vec::Vec<_> = message
+            .field()
+            .iter()
+            .map(|&field| match inline_fields.iter().find(|f| f.0 == field.number()) {
+                Some(&(_, size, align)) => {
+                    Layout::from_size_align(size as usize, align as usize).unwrap()
+                }
+                None => field_layout(field),
+            })
+            .collect();
+        let declaration_order: std::vec::Vec<_> = (0..field_layouts.len())
+            .filter(|i| !bool_bits.contains(i))
+            .collect();
+        let (declared, declared_offsets) =
+            place_fields(has_bits, &field_layouts, &declaration_order);
+        let (layout, mut offsets, field_order) = if self.options.reorder_fields {
+            let order = packed_order(has_bits, &field_layouts, &declaration_order);
+            let (layout, offsets) = place_fields(has_bits, &field_layouts, &order);
+            (layout, offsets, order)
+        } else {
+            (declared, declared_offsets, declaration_order)
+        };
+        for (k, &i) in bool_bits.iter().enumerate() {
+            offsets[i] = (num_has_bits + k) as u32;
+        }
+        MessageLayout {
+            size: layout.size() as u32,
+            align: layout.align() as u32,
+            declared_size: declared.size() as u32,
+            has_bits_words: has_bits_words as u32,
+            offsets,
+            field_order,
+            options: self.options,
+            inline_fields: inline_fields.iter().map(|f| f.0).collect(),
+            unchecked_strings: std::vec::Vec::new(),
+        }
+    }
+}
+
+// Places the fields one after the other in `order`, as `#[repr(C)]` does. Returns the
+// padded struct layout and the offset of each field, indexed like `fields`.
+#[cfg(feature = "std")]
+fn place_fields(
+    has_bits: std::alloc::Layout,
+    fields: &[std::alloc::Layout],
+    order: &[usize],
+) -> (std::alloc::Layout, std::vec::Vec<u32>) {
+    let mut layout = has_bits;
+    let mut offsets = vec![0; fields.len()];
+    for &i in order {
+        let (new_layout, offset) = layout.extend(fields[i]).unwrap();
+        offsets[i] = offset as u32;
+        layout = new_layout;
+    }
+    (layout.pad_to_align(), offsets)
+}
+
+// Orders the fields in `stored` to avoid padding. The next field is the most aligned one
+// that needs no padding where the previous one ended, or the most aligned one if all need
+// padding. Fields of equal alignment keep their declaration order.
+#[cfg(feature = "std")]
+fn packed_order(
+    has_bits: std::alloc::Layout,
+    fields: &[std::alloc::Layout],
+    stored: &[usize],
+) -> std::vec::Vec<usize> {
+    let mut remaining = stored.to_vec();
+    remaining.sort_by_key(|&i| core::cmp::Reverse(fields[i].align()));
+    let mut order = std::vec::Vec::with_capacity(stored.len());
+    let mut end = has_bits.size();
+    while !remaining.is_empty() {
+        let next = remaining
+            .iter()
+            .position(|&i| end % fields[i].align() == 0)
+            .unwrap_or(0);
+        let i = remaining.remove(next);
+        end = end.next_multiple_of(fields[i].align()) + fields[i].size();
+        order.push(i);
+    }
+    order
+}
+
+#[cfg(feature = "std")]
+fn field_layout(field: &FieldDescriptorProto) -> std::alloc::Layout {
+    use Type::*;
+    use std::alloc::Layout;
+
+    if is_repeated(field) {
+        return Layout::new::<crate::containers::RepeatedField<u8>>();
+    }
+    match field.r#type().unwrap() {
+        TYPE_BOOL => Layout::new::<bool>(),
+        TYPE_INT32 | TYPE_UINT32 | TYPE_SINT32 | TYPE_FIXED32 | TYPE_SFIXED32 | TYPE_FLOAT
+        | TYPE_ENUM => Layout::new::<u32>(),
+        TYPE_INT64 | TYPE_UINT64 | TYPE_SINT64 | TYPE_FIXED64 | TYPE_SFIXED64 | TYPE_DOUBLE => {
+            Layout::new::<u64>()
+        }
+        TYPE_STRING | TYPE_BYTES => Layout::new::<String>(),
+        TYPE_MESSAGE if is_lazy(field) => Layout::new::<LazyMessage>(),
+        TYPE_MESSAGE | TYPE_GROUP => Layout::new::<Message>(),
+    }
+}
+
+/// Where the fields of a message live in its struct, which starts with the has bits.
+#[cfg(feature = "std")]
+#[derive(Clone, Debug)]
+pub struct MessageLayout {
+    pub size: u32,
+    pub align: u32,
+    /// Size the struct would have with its fields in declaration order
+    pub declared_size: u32,
+    /// Length of the has bits array, which also holds the bools stored as bits
+    pub has_bits_words: u32,
+    /// Offset of each field, in the order of `DescriptorProto::field`. For bools stored as
+    /// bits this is the index of the bit.
+    pub offsets: std::vec::Vec<u32>,
+    /// Indices into `DescriptorProto::field`, in the order the fields are stored in the
+    /// struct
+    pub field_order: std::vec::Vec<usize>,
+    options: LayoutOptions,
+    // Numbers of the message fields embedded in the struct
+    inline_fields: std::vec::Vec<i32>,
+    // Numbers of the string fields that are not validated as UTF-8, and decode as bytes
+    unchecked_strings: std::vec::Vec<i32>,
+}
+
+#[cfg(feature = "std")]
+impl MessageLayout {
+    /// Whether the submessage of `field` is embedded in the struct.
+    pub fn is_inline(&self, field: &FieldDescriptorProto) -> bool {
+        self.inline_fields.contains(&field.number())
+    }
 
-pub fn field_kind_tokens(field: &&FieldDescriptorProto) -> wire::FieldKind {
+    pub fn field_kind(&self, field: &FieldDescriptorProto) -> wire::FieldKind {
+        if self.is_inline(field) {
+            return wire::FieldKind::InlineMessage;
+        }
+        match field_kind_tokens(&field, self.options) {
+            wire::FieldKind::String if self.is_unchecked(field) => wire::FieldKind::Bytes,
+            wire::FieldKind::RepeatedString if self.is_unchecked(field) => {
+                wire::FieldKind::RepeatedBytes
+            }
+            kind => kind,
+        }
+    }
+
+    // Whether the string field is decoded without validating UTF-8
+    fn is_unchecked(&self, field: &FieldDescriptorProto) -> bool {
+        self.unchecked_strings.contains(&field.number())
+    }
+
+    /// The fields that have a has bit, in the order of their bits.
+    pub fn has_bit_fields<'m>(
+        &self,
+        message: &'m DescriptorProto,
+    ) -> std::vec::Vec<&'m FieldDescriptorProto> {
+        message
+            .field()
+            .iter()
+            .copied()
+            .filter(|f| needs_has_bit(f) || self.is_inline(f))
+            .collect()
+    }
+}
+
+pub fn field_kind_tokens(field: &&FieldDescriptorProto, options: LayoutOptions) -> wire::FieldKind {
     if field.label().unwrap() == Label::LABEL_REPEATED {
         match field.r#type().unwrap() {
             Type::TYPE_INT32 => wire::FieldKind::RepeatedInt32,
@@ -27,7 +369,11 @@ pub fn field_kind_tokens(field: &&FieldDescriptorProto) -> wire::FieldKind {
                 wire::FieldKind::RepeatedFixed64
             }
             Type::TYPE_BOOL => wire::FieldKind::RepeatedBool,
-            Type::TYPE_STRING | Type::TYPE_BYTES => wire::FieldKind::RepeatedBytes,
+            Type::TYPE_STRING => wire::FieldKind::RepeatedString,
+            Type::TYPE_BYTES => wire::FieldKind::RepeatedBytes,
+            Type::TYPE_MESSAGE if options.inline_repeated_messages => {
+                wire::FieldKind::RepeatedInlineMessage
+            }
             Type::TYPE_MESSAGE => wire::FieldKind::RepeatedMessage,
             Type::TYPE_GROUP => wire::FieldKind::RepeatedGroup,
             Type::TYPE_ENUM => wire::FieldKind::RepeatedInt32,
@@ -43,8 +389,11 @@ pub fn field_kind_tokens(field: &&FieldDescriptorProto) -> wire::FieldKind {
             Type::TYPE_FIXED64 | Type::TYPE_SFIXED64 | Type::TYPE_DOUBLE => {
                 wire::FieldKind::Fixed64
             }
+            Type::TYPE_BOOL if options.bool_bits => wire::FieldKind::BoolBit,
             Type::TYPE_BOOL => wire::FieldKind::Bool,
-            Type::TYPE_STRING | Type::TYPE_BYTES => wire::FieldKind::Bytes,
+            Type::TYPE_STRING => wire::FieldKind::String,
+            Type::TYPE_BYTES => wire::FieldKind::Bytes,
+            Type::TYPE_MESSAGE if is_lazy(field) => wire::FieldKind::LazyMessage,
             Type::TYPE_MESSAGE => wire::FieldKind::Message,
             Type::TYPE_GROUP => wire::FieldKind::Group,
             Type::TYPE_ENUM => wire::FieldKind::Int32,
@@ -107,6 +456,24 @@ pub fn is_message(field: &FieldDescriptorProto) -> bool {
     )
 }
 
+/// Singular submessage marked `[lazy = true]`, which is decoded on first access.
+pub fn is_lazy(field: &FieldDescriptorProto) -> bool {
+    field.r#type() == Some(Type::TYPE_MESSAGE)
+        && !is_repeated(field)
+        && field.options().is_some_and(|opts| opts.lazy())
+}
+
+// Whether strings validate UTF-8 under `features`, given the setting they inherit from the
+// enclosing message or file.
+#[cfg(feature = "std")]
+fn validates_utf8(features: Option<&FeatureSet>, inherited: bool) -> bool {
+    match features.and_then(|features| features.utf8_validation()) {
+        Some(Utf8Validation::VERIFY) => true,
+        Some(Utf8Validation::NONE) => false,
+        _ => inherited,
+    }
+}
+
 pub fn needs_has_bit(field: &FieldDescriptorProto) -> bool {
     !is_repeated(field) && !is_message(field)
 }
@@ -136,16 +503,26 @@ pub fn debug_message<'msg, T: Protobuf>(
     core::fmt::Debug::fmt(&dynamic_msg, f)
 }
 
+#[cfg(feature = "std")]
 pub struct DescriptorPool<'alloc> {
     pub arena: Arena<'alloc>,
     tables: std::collections::HashMap<std::string::String, &'alloc mut Table>,
+    layouts: MessageLayouts<'alloc>,
 }
 
+#[cfg(feature = "std")]
 impl<'alloc> DescriptorPool<'alloc> {
     pub fn new(alloc: &'alloc dyn core::alloc::Allocator) -> Self {
+        Self::with_layout(alloc, LayoutOptions::default())
+    }
+
+    /// Create a pool whose messages are laid out according to `layout`, e.g. to read
+    /// messages of code generated with the same options.
+    pub fn with_layout(alloc: &'alloc dyn core::alloc::Allocator, layout: LayoutOptions) -> Self {
         DescriptorPool {
             arena: Arena::new(alloc),
             tables: std::collections::HashMap::new(),
+            layouts: MessageLayouts::new(layout),
         }
     }
 
@@ -156,6 +533,7 @@ impl<'alloc> DescriptorPool<'alloc> {
 
     /// Add a FileDescriptorProto to the pool
     pub fn add_file(&mut self, file: &'alloc FileDescriptorProto) {
+        self.layouts.add_file(file);
         let package = if file.has_package() {
             file.package()
         } else {
@@ -219,7 +597,15 @@ impl<'alloc> DescriptorPool<'alloc> {
         // Get aux entry pointer - must use same Layout::extend logic as build_table_from_descriptor
         unsafe {
             // Recalculate aux offset using Layout::extend (accounts for padding)
-            let table_layout = std::alloc::Layout::new::<Table>();
+            let table_layout = std::alloc::Layout::new::<Table>()
+                .extend(
+                    std::alloc::Layout::array::<crate::decoding::FastEntry>(
+                        crate::decoding::NUM_FAST_ENTRIES,
+                    )
+                    .unwrap(),
+                )
+                .unwrap()
+                .0;
             let (_, aux_offset_from_table) = table_layout
                 .extend(
                     std::alloc::Layout::array::<crate::decoding::TableEntry>(
@@ -305,7 +691,11 @@ impl<'alloc> DescriptorPool<'alloc> {
         // Allocate object with proper alignment (8 bytes for all protobuf types)
         let layout = std::alloc::Layout::from_size_align(table.size as usize, 8)
             .map_err(|e| anyhow::anyhow!("Invalid layout: {}", e))?;
-        let ptr = arena.alloc_raw(layout).as_ptr() as *mut Object;
+        let checkpoint = arena.checkpoint();
+        let ptr = arena
+            .try_alloc_raw(layout)
+            .map_err(|_| anyhow::anyhow!("Allocation failed"))?
+            .as_ptr() as *mut Object;
         assert!((ptr as usize) & 7 == 0);
         let object = unsafe {
             // Zero-initialize the object
@@ -313,8 +703,11 @@ impl<'alloc> DescriptorPool<'alloc> {
             &mut *ptr
         };
 
-        // Decode
-        self.decode_into(object, table, bytes, arena)?;
+        // Decode, on failure the object is released with everything else it allocated
+        if let Err(err) = self.decode_into(object, table, bytes, arena) {
+            unsafe { arena.rollback(checkpoint) };
+            return Err(err);
+        }
 
         Ok(DynamicMessage { object, table })
     }
@@ -328,14 +721,8 @@ impl<'alloc> DescriptorPool<'alloc> {
     ) -> &'alloc mut Table {
         use crate::{decoding, encoding, tables::AuxTableEntry};
 
-        // Calculate sizes
         let num_fields = descriptor.field().len();
-        let num_has_bits = descriptor
-            .field()
-            .iter()
-            .filter(|f| needs_has_bit(f))
-            .count();
-        let has_bits_size = (num_has_bits.div_ceil(32) * 4) as u32;
+        let message_layout = self.layouts.layout(descriptor);
 
         // Calculate max field number for sparse decode table
         let max_field_number = descriptor
@@ -351,26 +738,13 @@ impl<'alloc> DescriptorPool<'alloc> {
 
         let num_decode_entries = (max_field_number + 1) as usize;
 
-        // Calculate field offsets and total size using Layout::extend for proper padding
-        // Start with has_bits layout (always u32 array, so alignment is 4)
-        let mut layout = std::alloc::Layout::from_size_align(has_bits_size as usize, 4).unwrap();
-        let mut field_offsets = std::vec::Vec::new();
-
-        for &field in descriptor.field() {
-            let field_size = self.field_size(field);
-            let field_align = self.field_align(field);
-            let field_layout =
-                std::alloc::Layout::from_size_align(field_size as usize, field_align as usize)
-                    .unwrap();
-
-            let (new_layout, offset) = layout.extend(field_layout).unwrap();
-            field_offsets.push((field, offset as u32));
-            layout = new_layout;
-        }
-
-        // Pad to struct alignment
-        let layout = layout.pad_to_align();
-        let total_size = layout.size() as u32;
+        let field_offsets: std::vec::Vec<_> = descriptor
+            .field()
+            .iter()
+            .copied()
+            .zip(message_layout.offsets.iter().copied())
+            .collect();
+        let total_size = message_layout.size;
 
         // Count message fields for aux entries
         let num_aux_entries = descriptor.field().iter().filter(|f| is_message(f)).count();
@@ -380,6 +754,12 @@ impl<'alloc> DescriptorPool<'alloc> {
         let (layout, table_offset) = encode_layout
             .extend(std::alloc::Layout::new::<Table>())
             .unwrap();
+        let (layout, fast_offset) = layout
+            .extend(
+                std::alloc::Layout::array::<decoding::FastEntry>(decoding::NUM_FAST_ENTRIES)
+                    .unwrap(),
+            )
+            .unwrap();
         let (layout, decode_offset) = layout
             .extend(std::alloc::Layout::array::<decoding::TableEntry>(num_decode_entries).unwrap())
             .unwrap();
@@ -390,6 +770,7 @@ impl<'alloc> DescriptorPool<'alloc> {
         let base_ptr = self.arena.alloc_raw(layout).as_ptr();
         let encode_ptr = base_ptr as *mut encoding::TableEntry;
         let table_ptr = unsafe { base_ptr.add(table_offset) as *mut Table };
+        let fast_ptr = unsafe { base_ptr.add(fast_offset) as *mut decoding::FastEntry };
         let decode_ptr = unsafe { base_ptr.add(decode_offset) as *mut decoding::TableEntry };
         let aux_ptr = unsafe { base_ptr.add(aux_offset) as *mut AuxTableEntry };
 
@@ -406,30 +787,26 @@ impl<'alloc> DescriptorPool<'alloc> {
 
             // Build aux index map for message fields and has_bit index map
             let mut aux_index_map = std::collections::HashMap::<i32, usize>::new();
-            let mut has_bit_index_map = std::collections::HashMap::<i32, u32>::new();
             let mut aux_idx = 0;
-            let mut has_bit_idx = 0u32;
             for &field in descriptor.field() {
                 if is_message(field) {
                     aux_index_map.insert(field.number(), aux_idx);
                     aux_idx += 1;
                 }
-                if needs_has_bit(field) {
-                    has_bit_index_map.insert(field.number(), has_bit_idx);
-                    has_bit_idx += 1;
-                }
             }
+            let has_bit_index_map: std::collections::HashMap<i32, u32> = message_layout
+                .has_bit_fields(descriptor)
+                .iter()
+                .enumerate()
+                .map(|(i, f)| (f.number(), i as u32))
+                .collect();
 
             // Build encode entries
-            let mut has_bit_idx = 0u8;
             for (i, &(field, offset)) in field_offsets.iter().enumerate() {
-                let has_bit = if needs_has_bit(field) {
-                    let bit = has_bit_idx;
-                    has_bit_idx += 1;
-                    bit
-                } else {
-                    0
-                };
+                let has_bit = has_bit_index_map
+                    .get(&field.number())
+                    .copied()
+                    .unwrap_or(0) as u8;
 
                 let entry_offset = if is_message(field) {
                     // For message fields, offset points to aux entry
@@ -444,7 +821,7 @@ impl<'alloc> DescriptorPool<'alloc> {
 
                 encode_ptr.add(i).write(encoding::TableEntry {
                     has_bit,
-                    kind: field_kind_tokens(&field),
+                    kind: message_layout.field_kind(field),
                     offset: entry_offset,
                     encoded_tag: calculate_tag_with_syntax(field, syntax),
                 });
@@ -464,8 +841,12 @@ impl<'alloc> DescriptorPool<'alloc> {
                             (aux_ptr as usize) + aux_index * core::mem::size_of::<AuxTableEntry>();
                         let table_addr = table_ptr as usize;
                         decoding::TableEntry::new(
-                            field_kind_tokens(field),
-                            0, // has_bit not used for message fields
+                            message_layout.field_kind(field),
+                            // Only used by inline message fields
+                            has_bit_index_map
+                                .get(&field_number)
+                                .copied()
+                                .unwrap_or(0),
                             aux_offset - table_addr,
                         )
                     } else {
@@ -474,13 +855,12 @@ impl<'alloc> DescriptorPool<'alloc> {
                             .find(|(f, _)| f.number() == field_number)
                             .map(|(_, o)| *o)
                             .unwrap_or(0);
-                        let has_bit = if needs_has_bit(field) {
-                            has_bit_index_map[&field_number]
-                        } else {
-                            0
-                        };
+                        let has_bit = has_bit_index_map
+                            .get(&field_number)
+                            .copied()
+                            .unwrap_or(0);
                         decoding::TableEntry::new(
-                            field_kind_tokens(field),
+                            message_layout.field_kind(field),
                             has_bit,
                             offset as usize,
                         )
@@ -494,6 +874,30 @@ impl<'alloc> DescriptorPool<'alloc> {
                 }
             }
 
+            // Build fast dispatch entries, lowest field number first so it wins its slot
+            for i in 0..decoding::NUM_FAST_ENTRIES {
+                fast_ptr.add(i).write(decoding::FastEntry::EMPTY);
+            }
+            let mut fast_fields = std::vec::Vec::new();
+            for &field in descriptor.field() {
+                let encoded_tag = calculate_tag_with_syntax(field, syntax);
+                if let Some(slot) = decoding::fast_slot(message_layout.field_kind(field), encoded_tag) {
+                    fast_fields.push((field.number(), slot, encoded_tag));
+                }
+            }
+            fast_fields.sort_unstable();
+            let mut used_slots = 0u32;
+            for (field_number, slot, encoded_tag) in fast_fields {
+                if used_slots & (1 << slot) != 0 {
+                    continue;
+                }
+                used_slots |= 1 << slot;
+                let entry = *decode_ptr.add(field_number as usize);
+                fast_ptr
+                    .add(slot)
+                    .write(decoding::FastEntry::new(encoded_tag, entry));
+            }
+
             // Build aux entries for message fields
             for (aux_index, &(field, offset)) in field_offsets
                 .iter()
@@ -517,44 +921,6 @@ impl<'alloc> DescriptorPool<'alloc> {
         }
     }
 
-    fn field_size(&self, field: &FieldDescriptorProto) -> u32 {
-        use Type::*;
-
-        if is_repeated(field) {
-            return core::mem::size_of::<crate::containers::RepeatedField<u8>>() as u32;
-        }
-
-        match field.r#type().unwrap() {
-            TYPE_BOOL => 1,
-            TYPE_INT32 | TYPE_UINT32 | TYPE_SINT32 | TYPE_FIXED32 | TYPE_SFIXED32 | TYPE_FLOAT
-            | TYPE_ENUM => 4,
-            TYPE_INT64 | TYPE_UINT64 | TYPE_SINT64 | TYPE_FIXED64 | TYPE_SFIXED64 | TYPE_DOUBLE => {
-                8
-            }
-            TYPE_STRING | TYPE_BYTES => core::mem::size_of::<String>() as u32,
-            TYPE_MESSAGE | TYPE_GROUP => core::mem::size_of::<Message>() as u32,
-        }
-    }
-
-    fn field_align(&self, field: &FieldDescriptorProto) -> u32 {
-        use Type::*;
-
-        if is_repeated(field) {
-            return core::mem::align_of::<crate::containers::RepeatedField<u8>>() as u32;
-        }
-
-        match field.r#type().unwrap() {
-            TYPE_BOOL => 1,
-            TYPE_INT32 | TYPE_UINT32 | TYPE_SINT32 | TYPE_FIXED32 | TYPE_SFIXED32 | TYPE_FLOAT
-            | TYPE_ENUM => 4,
-            TYPE_INT64 | TYPE_UINT64 | TYPE_SINT64 | TYPE_FIXED64 | TYPE_SFIXED64 | TYPE_DOUBLE => {
-                8
-            }
-            TYPE_STRING | TYPE_BYTES => core::mem::align_of::<String>() as u32,
-            TYPE_MESSAGE | TYPE_GROUP => core::mem::align_of::<Message>() as u32,
-        }
-    }
-
     fn decode_into(
         &self,
         object: &mut Object,
@@ -738,14 +1104,12 @@ impl<'pool, 'msg> DynamicMessageRef<'pool, 'msg> {
                 }
                 Type::TYPE_MESSAGE | Type::TYPE_GROUP => {
                     let aux = self.table.aux_entry_decode(entry);
-                    let slice = self.object.get_slice::<Message>(aux.offset as usize);
-                    if slice.is_empty() {
+                    let table = unsafe { &*aux.child_table };
+                    let objects = RepeatedObjects::new(self.object, entry.kind(), aux.offset, table);
+                    if objects.len() == 0 {
                         return None;
                     }
-                    let dynamic_array = DynamicMessageArray {
-                        object: slice,
-                        table: unsafe { &*aux.child_table },
-                    };
+                    let dynamic_array = DynamicMessageArray { objects, table };
                     Some(Value::RepeatedMessage(dynamic_array))
                 }
             }
@@ -765,6 +1129,9 @@ impl<'pool, 'msg> DynamicMessageRef<'pool, 'msg> {
                 }
                 Type::TYPE_FLOAT => Value::Float(self.object.get(entry.offset() as usize)),
                 Type::TYPE_DOUBLE => Value::Double(self.object.get(entry.offset() as usize)),
+                Type::TYPE_BOOL if entry.kind() == wire::FieldKind::BoolBit => {
+                    Value::Bool(self.object.bit(entry.offset()))
+                }
                 Type::TYPE_BOOL => Value::Bool(self.object.get(entry.offset() as usize)),
                 Type::TYPE_STRING => Value::String(
                     self.object
@@ -777,14 +1144,22 @@ impl<'pool, 'msg> DynamicMessageRef<'pool, 'msg> {
                 Type::TYPE_MESSAGE | Type::TYPE_GROUP => {
                     let aux_entry = self.table.aux_entry_decode(entry);
                     let offset = aux_entry.offset as usize;
-                    let msg = self.object.get::<Message>(offset);
-                    if msg.0.is_null() {
-                        return None;
-                    }
-                    let dynamic_msg = DynamicMessageRef {
-                        object: unsafe { &*msg.0 },
-                        table: unsafe { &*aux_entry.child_table },
+                    let table = unsafe { &*aux_entry.child_table };
+                    let object = if is_lazy(field) {
+                        self.object.ref_at::<LazyMessage>(offset).get(table)?
+                    } else if entry.kind() == wire::FieldKind::InlineMessage {
+                        if !self.object.has_bit(entry.has_bit_idx() as u8) {
+                            return None;
+                        }
+                        self.object.ref_at::<Object>(offset)
+                    } else {
+                        let msg = self.object.get::<Message>(offset);
+                        if msg.0.is_null() {
+                            return None;
+                        }
+                        unsafe { &*msg.0 }
                     };
+                    let dynamic_msg = DynamicMessageRef { object, table };
                     return Some(Value::Message(dynamic_msg));
                 }
             };
@@ -846,34 +1221,32 @@ impl<'pool, 'msg> ProtobufMut<'pool> for DynamicMessage<'pool, 'msg> {
 }
 
 pub struct DynamicMessageArray<'pool, 'msg> {
-    pub object: &'msg [Message],
-    pub table: &'pool Table,
+    objects: RepeatedObjects<'msg>,
+    table: &'pool Table,
 }
 
 impl<'pool, 'msg> core::fmt::Debug for DynamicMessageArray<'pool, 'msg> {
     fn fmt(&self, f: &mut core::fmt::Formatter<'_>) -> core::fmt::Result {
-        f.debug_list()
-            .entries(self.object.iter().map(|msg| DynamicMessageRef {
-                object: unsafe { &*msg.0 },
-                table: self.table,
-            }))
-            .finish()
+        f.debug_list().entries(self.iter()).finish()
     }
 }
 
 impl<'pool, 'msg> DynamicMessageArray<'pool, 'msg> {
     pub fn len(&self) -> usize {
-        self.object.len()
+        self.objects.len()
     }
 
     pub fn is_empty(&self) -> bool {
-        self.object.is_empty()
+        self.objects.len() == 0
+    }
+
+    pub fn table(&self) -> &'pool Table {
+        self.table
     }
 
     pub fn get(&self, index: usize) -> DynamicMessageRef<'pool, 'msg> {
-        let obj = self.object[index];
         DynamicMessageRef {
-            object: unsafe { &*obj.0 },
+            object: self.objects.get(index),
             table: self.table,
         }
     }
@@ -883,7 +1256,7 @@ impl<'pool, 'msg> DynamicMessageArray<'pool, 'msg> {
         'msg: 'a,
     {
         DynamicMessageArrayIter {
-            object: self.object,
+            objects: self.objects,
             table: self.table,
             index: 0,
         }
@@ -892,7 +1265,7 @@ impl<'pool, 'msg> DynamicMessageArray<'pool, 'msg> {
 
 // Iterator struct - holds the data directly instead of borrowing the array
 pub struct DynamicMessageArrayIter<'pool, 'a> {
-    object: &'a [Message],
+    objects: RepeatedObjects<'a>,
     table: &'pool Table,
     index: usize,
 }
@@ -901,11 +1274,11 @@ impl<'pool, 'a> Iterator for DynamicMessageArrayIter<'pool, 'a> {
     type Item = DynamicMessageRef<'pool, 'a>;
 
     fn next(&mut self) -> Option<Self::Item> {
-        if self.index < self.object.len() {
-            let obj = self.object[self.index];
+        if self.index < self.objects.len() {
+            let object = self.objects.get(self.index);
             self.index += 1;
             Some(DynamicMessageRef {
-                object: unsafe { &*obj.0 },
+                object,
                 table: self.table,
             })
         } else {
@@ -914,14 +1287,14 @@ impl<'pool, 'a> Iterator for DynamicMessageArrayIter<'pool, 'a> {
     }
 
     fn size_hint(&self) -> (usize, Option<usize>) {
-        let remaining = self.object.len() - self.index;
+        let remaining = self.objects.len() - self.index;
         (remaining, Some(remaining))
     }
 }
 
 impl<'pool, 'a> ExactSizeIterator for DynamicMessageArrayIter<'pool, 'a> {
     fn len(&self) -> usize {
-        self.object.len() - self.index
+        self.objects.len() - self.index
     }
 }
 
@@ -932,7 +1305,7 @@ impl<'pool, 'msg> IntoIterator for &DynamicMessageArray<'pool, 'msg> {
 
     fn into_iter(self) -> Self::IntoIter {
         DynamicMessageArrayIter {
-            object: self.object,
+            objects: self.objects,
             table: self.table,
             index: 0,
         }
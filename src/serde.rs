@@ -345,17 +345,17 @@ impl<'msg> serde::Serialize for DynamicMessageArray<'static, 'msg> {
         S: serde::Serializer,
     {
         if self
-            .table
+            .table()
             .descriptor
             .options()
             .map(|o| o.map_entry())
             .unwrap_or(false)
         {
             use serde::ser::SerializeMap;
-            let mut map_serializer = serializer.serialize_map(Some(self.object.len()))?;
+            let mut map_serializer = serializer.serialize_map(Some(self.len()))?;
 
             let mut seen_keys = std::collections::hash_set::HashSet::<MapKey>::new();
-            for index in (0..self.object.len()).rev() {
+            for index in (0..self.len()).rev() {
                 let entry = self.get(index);
                 let key_field = entry
                     .find_field_descriptor_by_number(1)
@@ -394,8 +394,8 @@ impl<'msg> serde::Serialize for DynamicMessageArray<'static, 'msg> {
             }
             return map_serializer.end();
         }
-        let mut seq_serializer = serializer.serialize_seq(Some(self.object.len()))?;
-        for index in 0..self.object.len() {
+        let mut seq_serializer = serializer.serialize_seq(Some(self.len()))?;
+        for index in 0..self.len() {
             seq_serializer.serialize_element(&self.get(index))?;
         }
         seq_serializer.end()
@@ -633,8 +633,39 @@ impl<'de> serde::de::Visitor<'de> for StructKeyVisitor<'_> {
     }
 }
 
+// A repeated message field being deserialized into.
+struct RepeatedMessageField<'b> {
+    obj: &'b mut Object,
+    offset: u32,
+    kind: crate::wire::FieldKind,
+}
+
+impl RepeatedMessageField<'_> {
+    // Appends a deserialized element. Fields that store their elements inline get a copy
+    // of the object.
+    fn push(&mut self, msg: &'static mut Object, table: &Table, arena: &mut crate::arena::Arena) {
+        if self.kind == crate::wire::FieldKind::RepeatedInlineMessage {
+            let elem = self
+                .obj
+                .add_inline_object(self.offset, table, arena)
+                .expect("Allocation failed");
+            unsafe {
+                core::ptr::copy_nonoverlapping(
+                    msg as *const Object as *const u8,
+                    elem as *mut Object as *mut u8,
+                    table.size as usize,
+                )
+            };
+        } else {
+            self.obj
+                .add(self.offset, crate::base::Message(msg), arena)
+                .expect("Allocation failed");
+        }
+    }
+}
+
 struct ProtobufArrayfVisitor<'arena, 'alloc, 'b> {
-    rf: &'b mut crate::containers::RepeatedField<crate::base::Message>,
+    rf: RepeatedMessageField<'b>,
     table: &'static Table,
     arena: &'arena mut crate::arena::Arena<'alloc>,
 }
@@ -665,7 +696,11 @@ impl<'de, 'arena, 'alloc, 'b> serde::de::Visitor<'de>
     where
         A: serde::de::SeqAccess<'de>,
     {
-        let ProtobufArrayfVisitor { rf, table, arena } = self;
+        let ProtobufArrayfVisitor {
+            mut rf,
+            table,
+            arena,
+        } = self;
         loop {
             let msg_obj = Object::create(table.size as u32, arena);
 
@@ -677,7 +712,7 @@ impl<'de, 'arena, 'alloc, 'b> serde::de::Visitor<'de>
 
             match seq.next_element_seed(seed)? {
                 Some(()) => {
-                    rf.push(crate::base::Message(msg_obj as *mut Object), arena);
+                    rf.push(msg_obj, table, arena);
                 }
                 None => {
                     return Ok(());
@@ -688,7 +723,7 @@ impl<'de, 'arena, 'alloc, 'b> serde::de::Visitor<'de>
 }
 
 struct ProtobufMapVisitor<'arena, 'alloc, 'b> {
-    rf: &'b mut crate::containers::RepeatedField<crate::base::Message>,
+    rf: RepeatedMessageField<'b>,
     table: &'static Table,
     arena: &'arena mut crate::arena::Arena<'alloc>,
 }
@@ -720,7 +755,11 @@ impl<'de, 'arena, 'alloc, 'b> serde::de::Visitor<'de> for ProtobufMapVisitor<'ar
     where
         A: serde::de::MapAccess<'de>,
     {
-        let ProtobufMapVisitor { rf, table, arena } = self;
+        let ProtobufMapVisitor {
+            mut rf,
+            table,
+            arena,
+        } = self;
 
         let key_field = table.descriptor.field()[0];
         let value_field = table.descriptor.field()[1];
@@ -737,7 +776,7 @@ impl<'de, 'arena, 'alloc, 'b> serde::de::Visitor<'de> for ProtobufMapVisitor<'ar
             match key_field.r#type().unwrap() {
                 Type::TYPE_BOOL => {
                     let key_val: bool = key_str.parse().map_err(serde::de::Error::custom)?;
-                    entry_obj.set::<bool>(key_entry.offset(), key_entry.has_bit_idx(), key_val);
+                    set_bool(entry_obj, key_entry, key_val);
                 }
                 Type::TYPE_INT32 | Type::TYPE_SINT32 | Type::TYPE_SFIXED32 => {
                     let key_val: i32 = key_str.parse().map_err(serde::de::Error::custom)?;
@@ -774,7 +813,7 @@ impl<'de, 'arena, 'alloc, 'b> serde::de::Visitor<'de> for ProtobufMapVisitor<'ar
             match value_field.r#type().unwrap() {
                 Type::TYPE_BOOL => {
                     let v: bool = map.next_value()?;
-                    entry_obj.set::<bool>(value_entry.offset(), value_entry.has_bit_idx(), v);
+                    set_bool(entry_obj, value_entry, v);
                 }
                 Type::TYPE_INT32 | Type::TYPE_SINT32 | Type::TYPE_SFIXED32 | Type::TYPE_ENUM => {
                     let v: i32 = map.next_value()?;
@@ -833,7 +872,7 @@ impl<'de, 'arena, 'alloc, 'b> serde::de::Visitor<'de> for ProtobufMapVisitor<'ar
                 }
             }
 
-            rf.push(crate::base::Message(entry_obj as *mut Object), arena);
+            rf.push(entry_obj, table, arena);
         }
         Ok(())
     }
@@ -1042,6 +1081,16 @@ impl<'de> serde::de::Visitor<'de> for FlexibleDoubleVisitor {
     }
 }
 
+// Stores a singular bool, which may be stored as a bit of the has bits array
+fn set_bool(obj: &mut Object, entry: crate::decoding::TableEntry, val: bool) {
+    if entry.kind() == crate::wire::FieldKind::BoolBit {
+        obj.set_has_bit(entry.has_bit_idx());
+        obj.set_bit(entry.offset(), val);
+    } else {
+        obj.set::<bool>(entry.offset(), entry.has_bit_idx(), val);
+    }
+}
+
 // Wrapper deserialization helpers
 fn deserialize_wrapper<'de, A, T>(
     obj: &mut Object,
@@ -1068,6 +1117,30 @@ where
     Ok(())
 }
 
+fn deserialize_wrapper_bool<'de, A>(
+    obj: &mut Object,
+    table: &Table,
+    mut map: A,
+) -> Result<(), A::Error>
+where
+    A: serde::de::MapAccess<'de>,
+{
+    let entry = table
+        .entry(1)
+        .ok_or_else(|| serde::de::Error::custom("BoolValue missing 'value' field in table"))?;
+
+    while let Some(key) = map.next_key::<std::string::String>()? {
+        if key == "value" {
+            let val: bool = map.next_value()?;
+            set_bool(obj, entry, val);
+            return Ok(());
+        } else {
+            map.next_value::<serde::de::IgnoredAny>()?;
+        }
+    }
+    Ok(())
+}
+
 fn deserialize_wrapper_string<'de, 'alloc, A>(
     obj: &mut Object,
     table: &Table,
@@ -1216,7 +1289,7 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                     .table
                     .entry(1)
                     .ok_or_else(|| E::custom("BoolValue missing field 1"))?;
-                self.obj.set::<bool>(entry.offset(), entry.has_bit_idx(), v);
+                set_bool(self.obj, entry, v);
                 Ok(())
             }
             _ => Err(E::invalid_type(serde::de::Unexpected::Bool(v), &self)),
@@ -1411,7 +1484,7 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
 
         // Check if this is a well-known type
         match detect_well_known_type(table.descriptor) {
-            WellKnownType::BoolValue => return deserialize_wrapper::<A, bool>(obj, table, map),
+            WellKnownType::BoolValue => return deserialize_wrapper_bool(obj, table, map),
             WellKnownType::Int32Value => return deserialize_wrapper::<A, i32>(obj, table, map),
             WellKnownType::Int64Value => return deserialize_wrapper::<A, i64>(obj, table, map),
             WellKnownType::UInt32Value => return deserialize_wrapper::<A, u32>(obj, table, map),
@@ -1444,7 +1517,8 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                             continue;
                         };
                         for v in slice {
-                            obj.add::<bool>(entry.offset(), v, arena);
+                            obj.add::<bool>(entry.offset(), v, arena)
+                                .map_err(|_| serde::de::Error::custom("Allocation failed"))?;
                         }
                     }
                     Type::TYPE_FIXED64 | Type::TYPE_UINT64 => {
@@ -1452,7 +1526,8 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                             continue;
                         };
                         for v in slice {
-                            obj.add::<u64>(entry.offset(), v, arena);
+                            obj.add::<u64>(entry.offset(), v, arena)
+                                .map_err(|_| serde::de::Error::custom("Allocation failed"))?;
                         }
                     }
                     Type::TYPE_FIXED32 | Type::TYPE_UINT32 => {
@@ -1460,7 +1535,8 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                             continue;
                         };
                         for v in slice {
-                            obj.add::<u32>(entry.offset(), v, arena);
+                            obj.add::<u32>(entry.offset(), v, arena)
+                                .map_err(|_| serde::de::Error::custom("Allocation failed"))?;
                         }
                     }
                     Type::TYPE_SFIXED64 | Type::TYPE_INT64 | Type::TYPE_SINT64 => {
@@ -1468,7 +1544,8 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                             continue;
                         };
                         for v in slice {
-                            obj.add::<i64>(entry.offset(), v, arena);
+                            obj.add::<i64>(entry.offset(), v, arena)
+                                .map_err(|_| serde::de::Error::custom("Allocation failed"))?;
                         }
                     }
                     Type::TYPE_SFIXED32
@@ -1479,7 +1556,8 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                             continue;
                         };
                         for v in slice {
-                            obj.add::<i32>(entry.offset(), v, arena);
+                            obj.add::<i32>(entry.offset(), v, arena)
+                                .map_err(|_| serde::de::Error::custom("Allocation failed"))?;
                         }
                     }
                     Type::TYPE_FLOAT => {
@@ -1487,7 +1565,8 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                             continue;
                         };
                         for v in slice {
-                            obj.add::<f32>(entry.offset(), v, arena);
+                            obj.add::<f32>(entry.offset(), v, arena)
+                                .map_err(|_| serde::de::Error::custom("Allocation failed"))?;
                         }
                     }
                     Type::TYPE_DOUBLE => {
@@ -1495,7 +1574,8 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                             continue;
                         };
                         for v in slice {
-                            obj.add::<f64>(entry.offset(), v, arena);
+                            obj.add::<f64>(entry.offset(), v, arena)
+                                .map_err(|_| serde::de::Error::custom("Allocation failed"))?;
                         }
                     }
                     Type::TYPE_STRING => {
@@ -1504,7 +1584,8 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                         };
                         for v in slice {
                             let s = crate::containers::String::from_str(&v, arena);
-                            obj.add::<crate::containers::String>(entry.offset(), s, arena);
+                            obj.add::<crate::containers::String>(entry.offset(), s, arena)
+                                .map_err(|_| serde::de::Error::custom("Allocation failed"))?;
                         }
                     }
                     Type::TYPE_BYTES => {
@@ -1513,7 +1594,8 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                         };
                         for v in slice {
                             let b = crate::containers::Bytes::from_slice(&v.0, arena);
-                            obj.add::<crate::containers::Bytes>(entry.offset(), b, arena);
+                            obj.add::<crate::containers::Bytes>(entry.offset(), b, arena)
+                                .map_err(|_| serde::de::Error::custom("Allocation failed"))?;
                         }
                     }
                     Type::TYPE_MESSAGE | Type::TYPE_GROUP => {
@@ -1522,10 +1604,11 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                             child_table,
                         } = table.aux_entry_decode(entry);
                         let child_table = unsafe { &*child_table };
-                        let rf = obj
-                            .ref_mut::<crate::containers::RepeatedField<crate::base::Message>>(
-                                offset,
-                            );
+                        let rf = RepeatedMessageField {
+                            obj: &mut *obj,
+                            offset,
+                            kind: entry.kind(),
+                        };
 
                         if child_table
                             .descriptor
@@ -1551,10 +1634,10 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                 },
                 _ => match field.r#type().unwrap() {
                     Type::TYPE_BOOL => {
-                        let Some(v) = map.next_value()? else {
+                        let Some(v) = map.next_value::<Option<bool>>()? else {
                             continue;
                         };
-                        obj.set::<bool>(entry.offset(), entry.has_bit_idx(), v);
+                        set_bool(obj, entry, v);
                     }
                     Type::TYPE_FIXED64 | Type::TYPE_UINT64 => {
                         let Some(v) = map.next_value_seed(Optional(FlexibleU64))? else {
@@ -1629,8 +1712,25 @@ impl<'de, 'arena, 'alloc, 'b, 'pool> serde::de::Visitor<'de> for ProtobufVisitor
                         if map.next_value_seed(seed)?.is_none() {
                             continue;
                         };
-                        *obj.ref_mut::<crate::base::Message>(offset) =
-                            crate::base::Message(child_obj);
+                        if crate::reflection::is_lazy(field) {
+                            // The object is already decoded, the nested arena needs no room
+                            let lazy = crate::base::LazyObject::create(0, arena);
+                            unsafe { (*lazy).set(child_obj) };
+                            *obj.ref_mut::<crate::base::LazyMessage>(offset) =
+                                crate::base::LazyMessage(lazy);
+                        } else if entry.kind() == crate::wire::FieldKind::InlineMessage {
+                            obj.set_has_bit(entry.has_bit_idx());
+                            unsafe {
+                                core::ptr::copy_nonoverlapping(
+                                    child_obj as *const Object as *const u8,
+                                    obj.ref_mut::<Object>(offset) as *mut Object as *mut u8,
+                                    child_table.size as usize,
+                                )
+                            };
+                        } else {
+                            *obj.ref_mut::<crate::base::Message>(offset) =
+                                crate::base::Message(child_obj);
+                        }
                     }
                 },
             }
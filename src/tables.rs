@@ -9,11 +9,17 @@ pub struct Table {
 impl Table {
     pub(crate) fn decode_entries(&self) -> &[crate::decoding::TableEntry] {
         unsafe {
-            let ptr = (self as *const Self).add(1) as *const crate::decoding::TableEntry;
+            let ptr = self.fast_entries().as_ptr_range().end as *const crate::decoding::TableEntry;
             core::slice::from_raw_parts(ptr, self.num_decode_entries as usize)
         }
     }
 
+    pub(crate) fn fast_entries(
+        &self,
+    ) -> &[crate::decoding::FastEntry; crate::decoding::NUM_FAST_ENTRIES] {
+        unsafe { &*((self as *const Self).add(1) as *const _) }
+    }
+
     pub(crate) fn encode_entries(&self) -> &[crate::encoding::TableEntry] {
         unsafe {
             let ptr = (self as *const _ as *const crate::encoding::TableEntry)
@@ -39,6 +45,7 @@ impl Table {
 pub struct TableWithEntries<const E: usize, const D: usize, const A: usize> {
     pub encode_entries: [crate::encoding::TableEntry; E],
     pub table: Table,
+    pub fast_entries: [crate::decoding::FastEntry; crate::decoding::NUM_FAST_ENTRIES],
     pub decode_entries: [crate::decoding::TableEntry; D],
     pub aux_entries: [AuxTableEntry; A],
 }
@@ -1,6 +1,7 @@
 use core::{
     ops::{Add, AddAssign, Index, IndexMut, Sub},
     ptr::NonNull,
+    sync::atomic::{AtomicPtr, Ordering},
 };
 
 pub(crate) const SLOP_SIZE: usize = 16;
@@ -16,61 +17,361 @@ pub fn zigzag_encode(n: i64) -> u64 {
 #[derive(Clone, Copy)]
 pub struct ReadCursor(pub NonNull<u8>);
 
-#[inline(never)]
-fn read_varint(ptr: *const u8) -> (*const u8, u64) {
-    let mut result = 0;
-    let mut extra = 0;
-    for i in 0..10 {
-        let b = unsafe { *ptr.add(i) };
-        if i == 9 && b != 1 {
-            break;
-        }
-        result ^= (b as u64) << (7 * i);
-        if b < 0x80 {
-            let new_ptr = unsafe { ptr.add(i + 1) };
-            return (new_ptr, result ^ extra);
-        }
-        extra ^= 0x80 << (7 * i);
+const CONTINUATION_BITS: u64 = 0x8080_8080_8080_8080;
+
+// Multi-byte varint kernels. A decode cursor always has SLOP_SIZE readable bytes past the
+// end of the chunk, so the kernels load the first 8 bytes of a varint with one unaligned
+// read and locate the terminating byte from the continuation bits, instead of looping
+// byte by byte. The 7-bit groups are then compacted with PEXT where BMI2 is available
+// and with a shift-and-mask (SWAR) sequence otherwise. The implementation is selected
+// once, on first use, by runtime feature detection.
+struct VarintKernels {
+    read_varint: unsafe fn(*const u8) -> (*const u8, u64),
+    read_varint32: unsafe fn(*const u8) -> (*const u8, u32),
+    read_tag: unsafe fn(*const u8) -> (*const u8, u32),
+    read_size: unsafe fn(*const u8) -> (*const u8, isize),
+}
+
+static KERNELS: AtomicPtr<VarintKernels> =
+    AtomicPtr::new(&DETECT_KERNELS as *const VarintKernels as *mut VarintKernels);
+
+static DETECT_KERNELS: VarintKernels = VarintKernels {
+    read_varint: |ptr| unsafe { (select_kernels().read_varint)(ptr) },
+    read_varint32: |ptr| unsafe { (select_kernels().read_varint32)(ptr) },
+    read_tag: |ptr| unsafe { (select_kernels().read_tag)(ptr) },
+    read_size: |ptr| unsafe { (select_kernels().read_size)(ptr) },
+};
+
+static SWAR_KERNELS: VarintKernels = VarintKernels {
+    read_varint: read_varint_kernel::<false>,
+    read_varint32: read_varint32_kernel::<false>,
+    read_tag: |ptr| unsafe {
+        let (ptr, value) = read_varint_u32_kernel::<false, 15>(ptr);
+        (ptr, value as u32)
+    },
+    read_size: |ptr| unsafe {
+        let (ptr, value) = read_varint_u32_kernel::<false, 7>(ptr);
+        (ptr, value as isize)
+    },
+};
+
+#[cfg(target_arch = "x86_64")]
+static BMI2_KERNELS: VarintKernels = VarintKernels {
+    read_varint: bmi2::read_varint,
+    read_varint32: bmi2::read_varint32,
+    read_tag: bmi2::read_tag,
+    read_size: bmi2::read_size,
+};
+
+#[cfg(target_arch = "x86_64")]
+mod bmi2 {
+    #[target_feature(enable = "bmi2")]
+    pub(super) unsafe fn read_varint(ptr: *const u8) -> (*const u8, u64) {
+        unsafe { super::read_varint_kernel::<true>(ptr) }
+    }
+
+    #[target_feature(enable = "bmi2")]
+    pub(super) unsafe fn read_varint32(ptr: *const u8) -> (*const u8, u32) {
+        unsafe { super::read_varint32_kernel::<true>(ptr) }
+    }
+
+    #[target_feature(enable = "bmi2")]
+    pub(super) unsafe fn read_tag(ptr: *const u8) -> (*const u8, u32) {
+        let (ptr, value) = unsafe { super::read_varint_u32_kernel::<true, 15>(ptr) };
+        (ptr, value as u32)
+    }
+
+    #[target_feature(enable = "bmi2")]
+    pub(super) unsafe fn read_size(ptr: *const u8) -> (*const u8, isize) {
+        let (ptr, value) = unsafe { super::read_varint_u32_kernel::<true, 7>(ptr) };
+        (ptr, value as isize)
+    }
+}
+
+fn has_bmi2() -> bool {
+    #[cfg(all(target_arch = "x86_64", feature = "std"))]
+    {
+        std::is_x86_feature_detected!("bmi2")
+    }
+    #[cfg(all(target_arch = "x86_64", not(feature = "std")))]
+    {
+        cfg!(target_feature = "bmi2")
+    }
+    #[cfg(not(target_arch = "x86_64"))]
+    {
+        false
+    }
+}
+
+#[cold]
+fn select_kernels() -> &'static VarintKernels {
+    #[cfg(target_arch = "x86_64")]
+    let kernels = if has_bmi2() {
+        &BMI2_KERNELS
+    } else {
+        &SWAR_KERNELS
+    };
+    #[cfg(not(target_arch = "x86_64"))]
+    let kernels = &SWAR_KERNELS;
+    KERNELS.store(
+        kernels as *const VarintKernels as *mut VarintKernels,
+        Ordering::Relaxed,
+    );
+    kernels
+}
+
+#[inline(always)]
+fn kernels() -> &'static VarintKernels {
+    unsafe { &*KERNELS.load(Ordering::Relaxed) }
+}
+
+#[inline(always)]
+unsafe fn load_word(ptr: *const u8) -> u64 {
+    u64::from_le(unsafe { core::ptr::read_unaligned(ptr as *const u64) })
+}
+
+// Gathers the low 7 bits of each byte into a contiguous value.
+#[inline(always)]
+fn compact<const BMI2: bool>(x: u64) -> u64 {
+    #[cfg(target_arch = "x86_64")]
+    if BMI2 {
+        return unsafe { core::arch::x86_64::_pext_u64(x, 0x7f7f_7f7f_7f7f_7f7f) };
+    }
+    let x = (x & 0x007f_007f_007f_007f) | ((x & 0x7f00_7f00_7f00_7f00) >> 1);
+    let x = (x & 0x0000_3fff_0000_3fff) | ((x & 0x3fff_0000_3fff_0000) >> 2);
+    (x & 0x0000_0000_0fff_ffff) | ((x & 0x0fff_ffff_0000_0000) >> 4)
+}
+
+// Only the first 5 bytes of a varint carry bits of a 32 bit value.
+#[inline(always)]
+fn compact32<const BMI2: bool>(x: u64) -> u32 {
+    #[cfg(target_arch = "x86_64")]
+    if BMI2 {
+        return unsafe { core::arch::x86_64::_pext_u64(x, 0x7f_7f7f_7f7f) as u32 };
+    }
+    ((x & 0x7f)
+        | ((x >> 1) & 0x3f80)
+        | ((x >> 2) & 0x1f_c000)
+        | ((x >> 3) & 0xfe0_0000)
+        | ((x >> 4) & 0xf000_0000)) as u32
+}
+
+// Mask of the bytes up to and including the terminating byte.
+#[inline(always)]
+fn length_mask(stop: u64) -> u64 {
+    stop ^ (stop - 1)
+}
+
+#[inline(always)]
+unsafe fn read_varint_kernel<const BMI2: bool>(ptr: *const u8) -> (*const u8, u64) {
+    let word = unsafe { load_word(ptr) };
+    let stop = !word & CONTINUATION_BITS;
+    if stop != 0 {
+        let len = (stop.trailing_zeros() / 8 + 1) as usize;
+        let value = compact::<BMI2>(word & length_mask(stop));
+        return (unsafe { ptr.add(len) }, value);
+    }
+    // 9 and 10 byte varints, i.e. large u64 and negative int32/int64 values.
+    let value = compact::<BMI2>(word);
+    let b8 = unsafe { *ptr.add(8) } as u64;
+    if b8 < 0x80 {
+        return (unsafe { ptr.add(9) }, value | (b8 << 56));
+    }
+    if unsafe { *ptr.add(9) } != 1 {
+        return (core::ptr::null(), 0);
+    }
+    (
+        unsafe { ptr.add(10) },
+        value | ((b8 & 0x7f) << 56) | (1 << 63),
+    )
+}
+
+// Decodes a varint truncated to 32 bits. Accepts exactly the encodings read_varint
+// accepts, but only the first 5 bytes contribute to the value; the remaining bytes of
+// a sign extended int32 are only skipped.
+#[inline(always)]
+unsafe fn read_varint32_kernel<const BMI2: bool>(ptr: *const u8) -> (*const u8, u32) {
+    let word = unsafe { load_word(ptr) };
+    let stop = !word & CONTINUATION_BITS;
+    if stop != 0 {
+        let len = (stop.trailing_zeros() / 8 + 1) as usize;
+        let value = compact32::<BMI2>(word & length_mask(stop));
+        return (unsafe { ptr.add(len) }, value);
     }
-    (core::ptr::null(), 0)
+    let len = if unsafe { *ptr.add(8) } < 0x80 {
+        9
+    } else if unsafe { *ptr.add(9) } == 1 {
+        10
+    } else {
+        return (core::ptr::null(), 0);
+    };
+    (unsafe { ptr.add(len) }, compact32::<BMI2>(word))
 }
 
-#[inline(never)]
-fn read_tag(ptr: *const u8) -> (*const u8, u32) {
-    let mut result = 0;
-    let mut extra = 0;
-    for i in 0..5 {
-        let b = unsafe { *ptr.add(i) };
-        if i == 4 && (b == 0 || b > 15) {
-            break;
+// Decodes a varint of at most 5 bytes whose last byte is limited to LAST_BYTE_MAX,
+// used for tags (u32) and lengths (limited to i32::MAX).
+#[inline(always)]
+unsafe fn read_varint_u32_kernel<const BMI2: bool, const LAST_BYTE_MAX: u64>(
+    ptr: *const u8,
+) -> (*const u8, u64) {
+    let word = unsafe { load_word(ptr) };
+    let stop = !word & CONTINUATION_BITS & 0xff_ffff_ffff;
+    if stop == 0 {
+        return (core::ptr::null(), 0);
+    }
+    let len = (stop.trailing_zeros() / 8 + 1) as usize;
+    if len == 5 {
+        let last = (word >> 32) & 0xff;
+        if last == 0 || last > LAST_BYTE_MAX {
+            return (core::ptr::null(), 0);
         }
-        result ^= (b as u32) << (7 * i);
-        if b < 0x80 {
-            let new_ptr = unsafe { ptr.add(i + 1) };
-            return (new_ptr, result ^ extra);
+    }
+    (
+        unsafe { ptr.add(len) },
+        compact::<BMI2>(word & length_mask(stop)),
+    )
+}
+
+// Bit i is set iff byte i of the 16 bytes at ptr has its continuation bit set. Packed
+// spans are scanned with this 16 bytes at a time, which never reads further past the
+// end of a span than the SLOP_SIZE bytes guaranteed to be readable.
+#[inline(always)]
+pub(crate) unsafe fn continuation_mask(ptr: *const u8) -> u32 {
+    #[cfg(target_arch = "x86_64")]
+    {
+        use core::arch::x86_64::{__m128i, _mm_loadu_si128, _mm_movemask_epi8};
+        unsafe { _mm_movemask_epi8(_mm_loadu_si128(ptr as *const __m128i)) as u32 }
+    }
+    #[cfg(not(target_arch = "x86_64"))]
+    {
+        // Move the high bit of every byte into the top byte with a multiply.
+        let movemask = |w: u64| ((((w & CONTINUATION_BITS) >> 7) * 0x0102_0408_1020_4080) >> 56);
+        let lo = movemask(unsafe { load_word(ptr) });
+        let hi = movemask(unsafe { load_word(ptr.add(8)) });
+        (lo | (hi << 8)) as u32
+    }
+}
+
+// Number of varints terminating in the len bytes at ptr.
+pub(crate) unsafe fn count_varints(ptr: *const u8, len: usize) -> usize {
+    let mut count = 0;
+    let mut offset = 0;
+    while offset + 16 <= len {
+        count += 16 - unsafe { continuation_mask(ptr.add(offset)) }.count_ones() as usize;
+        offset += 16;
+    }
+    if offset < len {
+        let tail = (1u32 << (len - offset)) - 1;
+        count += (!unsafe { continuation_mask(ptr.add(offset)) } & tail).count_ones() as usize;
+    }
+    count
+}
+
+// UTF-8 validation of string fields. Runs of ASCII are skipped 32 or 16 bytes at a time
+// with the movemask above. From the first non-ASCII byte on, sequences are checked with
+// the lead byte lookup tables below, until the input returns to ASCII.
+
+// Length of the sequence started by each byte, 0 if the byte cannot start a sequence.
+static UTF8_WIDTH: [u8; 256] = {
+    let mut table = [0; 256];
+    let mut b = 0;
+    while b < 256 {
+        table[b] = match b {
+            0x00..=0x7f => 1,
+            0xc2..=0xdf => 2,
+            0xe0..=0xef => 3,
+            0xf0..=0xf4 => 4,
+            _ => 0,
+        };
+        b += 1;
+    }
+    table
+};
+
+// Range of the second byte of each lead byte, which rules out overlong encodings,
+// surrogates and code points past U+10FFFF.
+static UTF8_SECOND: [(u8, u8); 256] = {
+    let mut table = [(0x80, 0xbf); 256];
+    table[0xe0] = (0xa0, 0xbf);
+    table[0xed] = (0x80, 0x9f);
+    table[0xf0] = (0x90, 0xbf);
+    table[0xf4] = (0x80, 0x8f);
+    table
+};
+
+#[inline(always)]
+unsafe fn is_ascii32(ptr: *const u8) -> bool {
+    #[cfg(target_arch = "x86_64")]
+    {
+        use core::arch::x86_64::{__m128i, _mm_loadu_si128, _mm_movemask_epi8, _mm_or_si128};
+        unsafe {
+            let lo = _mm_loadu_si128(ptr as *const __m128i);
+            let hi = _mm_loadu_si128(ptr.add(16) as *const __m128i);
+            _mm_movemask_epi8(_mm_or_si128(lo, hi)) == 0
         }
-        extra ^= 0x80 << (7 * i);
     }
-    (core::ptr::null(), 0)
+    #[cfg(not(target_arch = "x86_64"))]
+    unsafe {
+        let word = load_word(ptr)
+            | load_word(ptr.add(8))
+            | load_word(ptr.add(16))
+            | load_word(ptr.add(24));
+        word & CONTINUATION_BITS == 0
+    }
 }
 
-#[inline(never)]
-fn read_size(ptr: *const u8) -> (*const u8, isize) {
-    let mut result = 0;
-    let mut extra = 0;
-    for i in 0..5 {
-        let b = unsafe { *ptr.add(i) };
-        if i == 4 && (b == 0 || b > 7) {
-            break;
+/// Validates `bytes` as UTF-8 that may be cut off in the middle of the last sequence.
+/// Returns the length of that incomplete sequence, or None if the bytes are not UTF-8.
+/// A string decoded in pieces is validated by passing the incomplete sequence again
+/// together with the next piece.
+pub(crate) fn validate_utf8_prefix(bytes: &[u8]) -> Option<usize> {
+    let len = bytes.len();
+    let ptr = bytes.as_ptr();
+    let mut i = 0;
+    while i < len {
+        while i + 32 <= len && unsafe { is_ascii32(ptr.add(i)) } {
+            i += 32;
         }
-        result ^= (b as isize) << (7 * i);
-        if b < 0x80 {
-            let new_ptr = unsafe { ptr.add(i + 1) };
-            return (new_ptr, result ^ extra);
+        if i + 16 <= len {
+            let mask = unsafe { continuation_mask(ptr.add(i)) };
+            if mask == 0 {
+                i += 16;
+                continue;
+            }
+            i += mask.trailing_zeros() as usize;
+        } else {
+            while i < len && bytes[i] < 0x80 {
+                i += 1;
+            }
+            if i == len {
+                break;
+            }
+        }
+        let lead = bytes[i];
+        let width = UTF8_WIDTH[lead as usize] as usize;
+        if width == 0 {
+            return None;
+        }
+        let available = width.min(len - i);
+        let (lo, hi) = UTF8_SECOND[lead as usize];
+        if available > 1 && !(lo..=hi).contains(&bytes[i + 1]) {
+            return None;
+        }
+        for k in 2..available {
+            if bytes[i + k] & 0xc0 != 0x80 {
+                return None;
+            }
         }
-        extra ^= 0x80 << (7 * i);
+        if available < width {
+            return Some(available);
+        }
+        i += width;
     }
-    (core::ptr::null(), 0)
+    Some(0)
+}
+
+pub(crate) fn validate_utf8(bytes: &[u8]) -> bool {
+    validate_utf8_prefix(bytes) == Some(0)
 }
 
 impl ReadCursor {
@@ -87,7 +388,24 @@ impl ReadCursor {
             *self += 1;
             Some(res)
         } else {
-            let (new_ptr, value) = read_varint(self.0.as_ptr());
+            let (new_ptr, value) = unsafe { (kernels().read_varint)(self.0.as_ptr()) };
+            if new_ptr.is_null() {
+                return None;
+            }
+            self.0 = unsafe { NonNull::new_unchecked(new_ptr as *mut u8) };
+            Some(value)
+        }
+    }
+
+    // Reads a varint truncated to 32 bits (used for int32, uint32 and sint32)
+    #[inline(always)]
+    pub fn read_varint32(&mut self) -> Option<u32> {
+        let res = self[0] as u32;
+        if core::hint::likely(res < 0x80) {
+            *self += 1;
+            Some(res)
+        } else {
+            let (new_ptr, value) = unsafe { (kernels().read_varint32)(self.0.as_ptr()) };
             if new_ptr.is_null() {
                 return None;
             }
@@ -103,7 +421,7 @@ impl ReadCursor {
             *self += 1;
             Some(res)
         } else {
-            let (new_ptr, value) = read_tag(self.0.as_ptr());
+            let (new_ptr, value) = unsafe { (kernels().read_tag)(self.0.as_ptr()) };
             if new_ptr.is_null() {
                 return None;
             }
@@ -120,7 +438,7 @@ impl ReadCursor {
             *self += 1;
             Some(res)
         } else {
-            let (new_ptr, value) = read_size(self.0.as_ptr());
+            let (new_ptr, value) = unsafe { (kernels().read_size)(self.0.as_ptr()) };
             if new_ptr.is_null() {
                 return None;
             }
@@ -193,7 +511,7 @@ impl Index<isize> for ReadCursor {
     }
 }
 
-fn varint_size(n: u64) -> isize {
+pub(crate) fn varint_size(n: u64) -> isize {
     let log2 = (n | 1).ilog2();
     ((log2 * 9 + 64 + 9) / 64) as isize
 }
@@ -288,6 +606,68 @@ impl IndexMut<isize> for WriteCursor {
     }
 }
 
+// Front to back counterpart of WriteCursor, used by the streaming encoder.
+#[derive(Clone, Copy)]
+pub struct ForwardWriteCursor(pub NonNull<u8>);
+
+impl ForwardWriteCursor {
+    pub fn new(buffer: &mut [u8]) -> (Self, NonNull<u8>) {
+        let begin = NonNull::new(buffer.as_mut_ptr()).unwrap();
+        (ForwardWriteCursor(begin), unsafe {
+            begin.add(buffer.len())
+        })
+    }
+
+    pub fn write_varint(&mut self, mut n: u64) {
+        let p = self.0.as_ptr();
+        let mut i = 0;
+        while n >= 0x80 {
+            unsafe { *p.add(i) = n as u8 | 0x80 };
+            n >>= 7;
+            i += 1;
+        }
+        unsafe { *p.add(i) = n as u8 };
+        self.0 = unsafe { self.0.add(i + 1) };
+    }
+
+    pub fn write_unaligned<T>(&mut self, value: T) {
+        unsafe {
+            core::ptr::write_unaligned(self.0.as_ptr() as *mut T, value);
+            self.0 = self.0.add(core::mem::size_of::<T>());
+        }
+    }
+
+    pub fn write_slice(&mut self, slice: &[u8]) {
+        unsafe {
+            core::ptr::copy_nonoverlapping(slice.as_ptr(), self.0.as_ptr(), slice.len());
+            self.0 = self.0.add(slice.len());
+        }
+    }
+
+    pub fn write_tag(&mut self, tag: u32) {
+        self.write_varint(tag as u64);
+    }
+}
+
+impl PartialEq<NonNull<u8>> for ForwardWriteCursor {
+    fn eq(&self, other: &NonNull<u8>) -> bool {
+        self.0.as_ptr() == other.as_ptr()
+    }
+}
+
+impl PartialOrd<NonNull<u8>> for ForwardWriteCursor {
+    fn partial_cmp(&self, other: &NonNull<u8>) -> Option<core::cmp::Ordering> {
+        Some(self.0.cmp(other))
+    }
+}
+
+impl Sub<NonNull<u8>> for ForwardWriteCursor {
+    type Output = isize;
+    fn sub(self, rhs: NonNull<u8>) -> Self::Output {
+        self.0.as_ptr() as isize - rhs.as_ptr() as isize
+    }
+}
+
 #[repr(u8)]
 #[derive(Clone, Copy, PartialEq, Eq, Debug)]
 pub enum FieldKind {
@@ -301,8 +681,10 @@ pub enum FieldKind {
     Fixed64,
     Fixed32,
     Bytes,
+    String,
     Message,
     Group,
+    LazyMessage,
     RepeatedVarint64,
     RepeatedVarint32,
     RepeatedInt32,
@@ -312,6 +694,201 @@ pub enum FieldKind {
     RepeatedFixed64,
     RepeatedFixed32,
     RepeatedBytes,
+    RepeatedString,
     RepeatedMessage,
     RepeatedGroup,
+    // Repeated message whose elements are stored inline and contiguously, `Table::size`
+    // bytes apart, instead of as pointers to separately allocated objects.
+    RepeatedInlineMessage,
+    // Singular message embedded in the parent object, present when its has bit is set.
+    InlineMessage,
+    // Singular bool whose value is a bit of the has bits array, the offset is its index.
+    BoolBit,
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    // Byte at a time reference decoder, returns (length, value).
+    fn reference_varint(bytes: &[u8], max_len: usize, last_byte_max: u8) -> Option<(usize, u64)> {
+        let mut result = 0u64;
+        for (i, &b) in bytes.iter().take(max_len).enumerate() {
+            if i == max_len - 1 && (b == 0 || b > last_byte_max) {
+                return None;
+            }
+            result |= ((b & 0x7f) as u64) << (7 * i);
+            if b < 0x80 {
+                return Some((i + 1, result));
+            }
+        }
+        None
+    }
+
+    fn encode(mut n: u64) -> Vec<u8> {
+        let mut out = Vec::new();
+        while n >= 0x80 {
+            out.push(n as u8 | 0x80);
+            n >>= 7;
+        }
+        out.push(n as u8);
+        out
+    }
+
+    fn inputs() -> Vec<Vec<u8>> {
+        let mut inputs = Vec::new();
+        let mut x = 0x9e37_79b9_7f4a_7c15u64;
+        for shift in 0..64 {
+            for delta in [0u64, 1, 0x55] {
+                inputs.push(encode((1u64 << shift).wrapping_sub(delta)));
+            }
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            inputs.push(encode(x >> shift));
+        }
+        inputs.push(encode(u64::MAX));
+        inputs.push(encode(-1i32 as i64 as u64));
+        inputs.push(encode(i32::MIN as i64 as u64));
+        // Malformed and non-canonical encodings
+        inputs.push(vec![0xff; 10]);
+        inputs.push(vec![
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02,
+        ]);
+        inputs.push(vec![
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00,
+        ]);
+        inputs.push(vec![0x80, 0x80, 0x80, 0x80, 0x00]);
+        inputs.push(vec![0xff, 0xff, 0xff, 0xff, 0x0f]);
+        inputs.push(vec![0xff, 0xff, 0xff, 0xff, 0x10]);
+        inputs.push(vec![0xff, 0xff, 0xff, 0xff, 0x07]);
+        inputs.push(vec![0xff, 0xff, 0xff, 0xff, 0x08]);
+        inputs
+    }
+
+    fn check_kernels(kernels: &VarintKernels) {
+        for input in inputs() {
+            let mut buf = input.clone();
+            buf.resize(input.len() + SLOP_SIZE, 0xff);
+            let ptr = buf.as_ptr();
+            let len_of = |p: *const u8| unsafe { p.offset_from(ptr) as usize };
+
+            let expected = reference_varint(&input, 10, 1);
+            let (p, value) = unsafe { (kernels.read_varint)(ptr) };
+            let actual = (!p.is_null()).then(|| (len_of(p), value));
+            assert_eq!(actual, expected, "read_varint {:x?}", input);
+
+            let (p, value) = unsafe { (kernels.read_varint32)(ptr) };
+            let actual = (!p.is_null()).then(|| (len_of(p), value as u64));
+            assert_eq!(
+                actual,
+                expected.map(|(len, v)| (len, v as u32 as u64)),
+                "read_varint32 {:x?}",
+                input
+            );
+
+            let expected = reference_varint(&input, 5, 15);
+            let (p, value) = unsafe { (kernels.read_tag)(ptr) };
+            let actual = (!p.is_null()).then(|| (len_of(p), value as u64));
+            assert_eq!(actual, expected, "read_tag {:x?}", input);
+
+            let expected = reference_varint(&input, 5, 7);
+            let (p, value) = unsafe { (kernels.read_size)(ptr) };
+            let actual = (!p.is_null()).then(|| (len_of(p), value as u64));
+            assert_eq!(actual, expected, "read_size {:x?}", input);
+        }
+    }
+
+    #[test]
+    fn swar_varint_kernels() {
+        check_kernels(&SWAR_KERNELS);
+    }
+
+    #[cfg(target_arch = "x86_64")]
+    #[test]
+    fn bmi2_varint_kernels() {
+        if has_bmi2() {
+            check_kernels(&BMI2_KERNELS);
+        }
+    }
+
+    #[test]
+    fn dispatched_varint_kernels() {
+        check_kernels(&DETECT_KERNELS);
+        check_kernels(kernels());
+    }
+
+    #[test]
+    fn count_packed_varints() {
+        let mut buf = Vec::new();
+        for input in inputs().iter().filter(|input| input.len() <= 10) {
+            buf.extend_from_slice(input);
+        }
+        let len = buf.len();
+        buf.resize(len + SLOP_SIZE, 0xff);
+        for start in 0..len {
+            for end in start..len.min(start + 40) {
+                let expected = buf[start..end].iter().filter(|&&b| b < 0x80).count();
+                let count = unsafe { count_varints(buf.as_ptr().add(start), end - start) };
+                assert_eq!(count, expected, "span {start}..{end}");
+            }
+        }
+    }
+
+    // Validates in two pieces, carrying the incomplete sequence like the decoder does.
+    fn validate_split(bytes: &[u8], split: usize) -> bool {
+        let Some(pending) = validate_utf8_prefix(&bytes[..split]) else {
+            return false;
+        };
+        validate_utf8(&bytes[split - pending..])
+    }
+
+    #[test]
+    fn utf8_validation() {
+        let pieces: [&[u8]; 14] = [
+            b"a",
+            b"0123456789abcdefghijklmnopqrstuvwxyz",
+            "\u{e9}".as_bytes(),
+            "\u{20ac}".as_bytes(),
+            "\u{1f600}".as_bytes(),
+            "\u{10ffff}".as_bytes(),
+            b"\xc0\x80",
+            b"\xe0\x80\x80",
+            b"\xed\xa0\x80",
+            b"\xf4\x90\x80\x80",
+            b"\xf8",
+            b"\x80",
+            b"\xe2\x82",
+            b"\xff",
+        ];
+        let mut seed = 0x2545_f491_4f6c_dd1du64;
+        for _ in 0..2000 {
+            seed = seed
+                .wrapping_mul(6364136223846793005)
+                .wrapping_add(1442695040888963407);
+            let mut bytes = Vec::new();
+            for _ in 0..(seed >> 60) {
+                seed = seed
+                    .wrapping_mul(6364136223846793005)
+                    .wrapping_add(1442695040888963407);
+                // Mostly valid pieces, so that long valid strings are covered too
+                let index = (seed >> 33) as usize % (pieces.len() * 2);
+                let index = if index < pieces.len() {
+                    index
+                } else {
+                    index % 6
+                };
+                bytes.extend_from_slice(pieces[index]);
+            }
+            let expected = core::str::from_utf8(&bytes).is_ok();
+            assert_eq!(validate_utf8(&bytes), expected, "{bytes:x?}");
+            for split in 0..=bytes.len() {
+                assert_eq!(
+                    validate_split(&bytes, split),
+                    expected,
+                    "{bytes:x?} at {split}"
+                );
+            }
+        }
+    }
 }